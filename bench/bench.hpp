@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+
+namespace bench {
+
+/*
+ *  Keeps the compiler from optimizing away a value computed in a benchmark
+ */
+inline volatile std::uintptr_t sink = 0;
+
+template <typename T>
+auto keep(const T & value) -> void {
+  sink = sink + static_cast<std::uintptr_t>(value);
+}
+
+/*
+ *  Number of failed `check`s, the benchmark exits with an error if any failed
+ */
+inline std::size_t failures = 0;
+
+/*
+ *  Verifies a result the benchmark relies on, ie. that a query reached the right handler
+ */
+inline auto check(bool ok, const char * what) -> void {
+  if (ok)
+    return;
+  std::fprintf(stderr, "check failed: %s\n", what);
+  ++failures;
+}
+
+/*
+ *  Runs `fn` `iterations` times and prints the average time of a single call
+ */
+template <typename F>
+auto run(const char * name, std::size_t iterations, F && fn) -> void {
+  using clock = std::chrono::steady_clock;
+
+  // Warm up caches and branch predictors before measuring
+  for (std::size_t i = 0; i < iterations / 10 + 1; ++i)
+    fn();
+
+  const auto start = clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+    fn();
+  const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+  std::printf("%-64s %12.2f ns/op\n", name, elapsed / static_cast<double>(iterations));
+}
+
+}
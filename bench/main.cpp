@@ -0,0 +1,616 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sdk/client_interface.hpp>
+#include <sdk/helper.hpp>
+
+#include "bench.hpp"
+#include "mock_client.hpp"
+
+static std::uint64_t listener_calls = 0;
+
+static auto on_chat_log(sdk::event_chat_log * e) -> void {
+  (void)e;
+  ++listener_calls;
+}
+
+static auto on_chat_log_batch(sdk::event_chat_log * items, std::size_t n) -> void {
+  (void)items;
+  listener_calls += n;
+}
+
+static auto on_chat_log_command(sdk::event_chat_log * e) -> void {
+  // What an unfiltered listener does to pick out its own command
+  if (std::strncmp(e->message, ".cmd", 4) == 0)
+    ++listener_calls;
+}
+
+// How a plugin adds a command without `register_command`, one parse per plugin and message
+static auto on_chat_send_parse(sdk::event_chat_send * e) -> void {
+  const std::string * message = reinterpret_cast<const std::string *>(e->message);
+  if (message->size() < 2 || (*message)[0] != '.')
+    return;
+
+  std::vector<std::string_view> args;
+  std::string_view rest(*message);
+  rest.remove_prefix(1);
+  while (!rest.empty()) {
+    const std::size_t space = rest.find(' ');
+    args.push_back(rest.substr(0, space));
+    rest.remove_prefix(space == std::string_view::npos ? rest.size() : space + 1);
+  }
+
+  if (!args.empty() && args[0] == "stats")
+    ++listener_calls;
+}
+
+static auto on_stats_command(const sdk::command_args * args) -> void {
+  listener_calls += args->argc;
+}
+
+static auto on_chat_send_cancel(sdk::event_chat_send * e) -> void {
+  e->action = sdk::event_action::CANCEL;
+}
+
+static auto on_chat_send(sdk::event_chat_send * e) -> void {
+  (void)e;
+  ++listener_calls;
+}
+
+class chat_counter {
+public:
+  auto on_chat_log(sdk::event_chat_log * e) -> void {
+    (void)e;
+    ++this->count;
+  }
+
+  std::uint64_t count = 0;
+};
+
+// -- Query routing
+
+static constexpr const char * QUERY_IDS[] = {
+  "register_callback", "unregister_callback", "parse", "tokenize",
+  "get_sender", "get_context", "set_filter", "clear_filter",
+  "get_history", "clear_history", "get_stats", "reset_stats",
+  "get_config", "set_config", "get_version", "get_vtable",
+};
+
+static constexpr std::size_t QUERY_ID_COUNT = sizeof(QUERY_IDS) / sizeof(QUERY_IDS[0]);
+
+class router_module : public sdk::module_intf {
+public:
+  explicit router_module(sdk::client_intf * client) {
+    this->ids.intern(client);
+  }
+
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override {
+    (void)ptr; (void)size;
+    for (std::size_t i = 0; i < QUERY_ID_COUNT; ++i)
+      if (std::strcmp(id, QUERY_IDS[i]) == 0)
+        return this->handle(i);
+    return false;
+  }
+
+  auto query_token(sdk::query_id id, void * ptr, std::uint64_t size) -> bool override {
+    (void)ptr; (void)size;
+    const std::size_t index = this->ids.find(id);
+    return index != QUERY_ID_COUNT && this->handle(index);
+  }
+
+private:
+  auto handle(std::size_t index) -> bool {
+    bench::keep(index);
+    return true;
+  }
+
+  sdk::query_id_table<QUERY_ID_COUNT> ids { QUERY_IDS };
+};
+
+class crtp_router_module : public sdk::query_router<crtp_router_module, sdk::module_intf> {
+public:
+  // One handler per route, `I` is the route's index in QUERY_IDS so misrouted queries are caught
+  template <std::size_t I>
+  auto handle(void * ptr, std::uint64_t size) -> bool {
+    bench::keep(size);
+    this->last = I;
+    return ptr != nullptr;
+  }
+
+  using routes = sdk::query_routes<
+    sdk::query_route<"register_callback",   &crtp_router_module::handle<0>>,
+    sdk::query_route<"unregister_callback", &crtp_router_module::handle<1>>,
+    sdk::query_route<"parse",               &crtp_router_module::handle<2>>,
+    sdk::query_route<"tokenize",            &crtp_router_module::handle<3>>,
+    sdk::query_route<"get_sender",          &crtp_router_module::handle<4>>,
+    sdk::query_route<"get_context",         &crtp_router_module::handle<5>>,
+    sdk::query_route<"set_filter",          &crtp_router_module::handle<6>>,
+    sdk::query_route<"clear_filter",        &crtp_router_module::handle<7>>,
+    sdk::query_route<"get_history",         &crtp_router_module::handle<8>>,
+    sdk::query_route<"clear_history",       &crtp_router_module::handle<9>>,
+    sdk::query_route<"get_stats",           &crtp_router_module::handle<10>>,
+    sdk::query_route<"reset_stats",         &crtp_router_module::handle<11>>,
+    sdk::query_route<"get_config",          &crtp_router_module::handle<12>>,
+    sdk::query_route<"set_config",          &crtp_router_module::handle<13>>,
+    sdk::query_route<"get_version",         &crtp_router_module::handle<14>>,
+    sdk::query_route<"get_vtable",          &crtp_router_module::handle<15>>
+  >;
+
+  std::size_t last = QUERY_ID_COUNT;
+};
+
+// -- Channels
+
+struct entity_update {
+  static constexpr const char CHANNEL_ID[] = "radar_entities";
+
+  std::uint64_t entity;
+  float         position[3];
+  float         velocity[3];
+};
+
+// A consumer reached through `query`, the update is copied on every call
+class entity_consumer : public sdk::module_intf {
+public:
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override {
+    if (size != sizeof(entity_update) || std::strcmp(id, "push_entity") != 0)
+      return false;
+    std::memcpy(&this->last, ptr, sizeof(entity_update));
+    bench::keep(this->last.entity);
+    return true;
+  }
+
+  using sdk::module_intf::query;
+
+  entity_update last {};
+};
+
+// --
+
+static auto bench_listener_churn(bench::mock_client & client) -> void {
+  bench::run("add_event_listener (EVENT_ID) + remove", 100000, [&] {
+    client.add_event_listener(sdk::event_chat_log::EVENT_ID, reinterpret_cast<void *>(&on_chat_log));
+    client.remove_event_listener(reinterpret_cast<void *>(&on_chat_log));
+  });
+
+  bench::run("add_event_listener<T> (EVENT_UID) + remove", 100000, [&] {
+    client.add_event_listener(&on_chat_log);
+    client.remove_event_listener(reinterpret_cast<void *>(&on_chat_log));
+  });
+
+  bench::run("add_event_listener<T> prioritized + remove", 100000, [&] {
+    client.add_event_listener(&on_chat_log, sdk::event_priority::FIRST);
+    client.remove_event_listener(reinterpret_cast<void *>(&on_chat_log));
+  });
+
+  bench::run("attach_event_listener<T> + detach", 100000, [&] {
+    client.detach_event_listener(client.attach_event_listener(&on_chat_log));
+  });
+
+  // Tearing down 1000 listeners spread over the events, ie. a large plugin unloading
+  std::vector<sdk::listener_handle> handles;
+  bench::run("register + remove_event_listener x1000", 100, [&] {
+    for (std::size_t i = 0; i < 500; ++i) {
+      client.add_event_listener(&on_chat_send);
+      client.add_event_listener(&on_chat_log);
+    }
+    for (std::size_t i = 0; i < 500; ++i) {
+      client.remove_event_listener(reinterpret_cast<void *>(&on_chat_send));
+      client.remove_event_listener(reinterpret_cast<void *>(&on_chat_log));
+    }
+    client.end_frame();
+  });
+
+  bench::run("attach + detach_event_listener x1000", 100, [&] {
+    for (std::size_t i = 0; i < 500; ++i) {
+      handles.push_back(client.attach_event_listener(&on_chat_send));
+      handles.push_back(client.attach_event_listener(&on_chat_log));
+    }
+    for (sdk::listener_handle h : handles)
+      client.detach_event_listener(h);
+    handles.clear();
+    client.end_frame();
+  });
+}
+
+static auto bench_dispatch(bench::mock_client & client) -> void {
+  static constexpr std::size_t COUNTS[] = { 1, 10, 100, 1000 };
+
+  sdk::event_chat_log e = {
+    .action       = sdk::event_action::NOTHING,
+    .message      = "hello",
+    .sender_name  = "steve",
+    .context      = "",
+    .display_text = nullptr,
+  };
+
+  char name[64];
+  std::size_t registered = 0;
+  for (std::size_t count : COUNTS) {
+    for (; registered < count; ++registered)
+      client.add_event_listener(&on_chat_log);
+
+    std::snprintf(name, sizeof(name), "dispatch event_chat_log, %zu listeners", count);
+    bench::run(name, 1000000 / count, [&] {
+      client.dispatch(&e);
+    });
+  }
+
+  for (; registered; --registered)
+    client.remove_event_listener(reinterpret_cast<void *>(&on_chat_log));
+
+  // Plugin state reached through a global against a bound member function
+  chat_counter counter;
+  std::vector<sdk::listener_handle> handles;
+  for (std::size_t i = 0; i < 100; ++i)
+    handles.push_back(client.attach_event_listener<&chat_counter::on_chat_log>(&counter));
+
+  bench::run("dispatch event_chat_log, 100 member listeners (ctx)", 10000, [&] {
+    client.dispatch(&e);
+  });
+
+  for (sdk::listener_handle h : handles)
+    client.detach_event_listener(h);
+  handles.clear();
+  client.end_frame();
+
+  // 100 command listeners of which none matches the message
+  for (std::size_t i = 0; i < 100; ++i)
+    handles.push_back(client.attach_event_listener(&on_chat_log_command));
+
+  bench::run("dispatch event_chat_log, 100 listeners checking a prefix", 10000, [&] {
+    client.dispatch(&e);
+  });
+
+  for (sdk::listener_handle h : handles)
+    client.detach_event_listener(h);
+  handles.clear();
+  client.end_frame();
+
+  static constexpr sdk::event_filter filters[] = { sdk::event_filter::prefix(sdk::filter_field::MESSAGE, ".cmd") };
+  for (std::size_t i = 0; i < 100; ++i)
+    handles.push_back(client.attach_event_listener(&on_chat_log, filters));
+
+  bench::run("dispatch event_chat_log, 100 prefix filtered listeners", 10000, [&] {
+    client.dispatch(&e);
+  });
+
+  for (sdk::listener_handle h : handles)
+    client.detach_event_listener(h);
+  handles.clear();
+  client.end_frame();
+
+  // 1000 observers of event_chat_log as batch listeners, flushed every 100 entries
+  for (std::size_t i = 0; i < 1000; ++i)
+    client.add_event_batch_listener(&on_chat_log_batch);
+
+  std::size_t pending = 0;
+  bench::run("dispatch event_chat_log, 1000 batch listeners / 100 per frame", 100000, [&] {
+    client.dispatch(&e);
+    if (++pending == 100) {
+      client.end_frame();
+      pending = 0;
+    }
+  });
+  client.end_frame();
+
+  for (std::size_t i = 0; i < 1000; ++i)
+    client.remove_event_listener(reinterpret_cast<void *>(&on_chat_log_batch));
+
+  // A prioritized filter cancelling ahead of 1000 listeners
+  for (std::size_t i = 0; i < 1000; ++i)
+    client.add_event_listener(&on_chat_send);
+  client.add_event_listener(&on_chat_send_cancel, sdk::event_priority::FIRST);
+
+  sdk::event_chat_send s = {
+    .action  = sdk::event_action::NOTHING,
+    .message = nullptr,
+  };
+
+  bench::run("dispatch event_chat_send, FIRST filter cancels 1000", 1000000, [&] {
+    s.action = sdk::event_action::NOTHING;
+    client.dispatch(&s);
+  });
+
+  client.remove_event_listener(reinterpret_cast<void *>(&on_chat_send_cancel));
+  for (std::size_t i = 0; i < 1000; ++i)
+    client.remove_event_listener(reinterpret_cast<void *>(&on_chat_send));
+}
+
+static auto bench_commands(bench::mock_client & client) -> void {
+  static constexpr std::size_t PLUGINS = 10;
+  static constexpr const char * NAMES[PLUGINS] = { "stats", "ping", "friends", "waypoint", "macro", "zoom", "radar", "timer", "note", "search" };
+
+  std::string           storage = ".stats steve 10 day";
+  sdk::event_chat_send  e       = {
+    .action  = sdk::event_action::NOTHING,
+    .message = reinterpret_cast<sdk::managed_string *>(&storage),
+  };
+
+  std::vector<sdk::listener_handle> handles;
+  for (std::size_t i = 0; i < PLUGINS; ++i)
+    handles.push_back(client.attach_event_listener(&on_chat_send_parse));
+
+  bench::run("command, 10 plugins parsing event_chat_send", 100000, [&] {
+    client.dispatch(&e);
+  });
+
+  for (sdk::listener_handle h : handles)
+    client.detach_event_listener(h);
+  client.end_frame();
+
+  for (std::size_t i = 0; i < PLUGINS; ++i)
+    client.register_command(nullptr, NAMES[i], &on_stats_command);
+
+  bench::run("command, 10 plugins with register_command", 100000, [&] {
+    client.dispatch(&e);
+  });
+
+  client.release_all(nullptr);
+}
+
+// Every ID has to reach its own handler, through strings, dense tokens and sparse tokens
+static auto check_query_routes(bench::mock_client & client) -> void {
+  crtp_router_module crtp;
+  crtp.intern_queries(&client);
+  sdk::sdk_intf * intf  = &crtp;
+  int             value = 0;
+
+  for (std::size_t i = 0; i < QUERY_ID_COUNT; ++i) {
+    crtp.last = QUERY_ID_COUNT;
+    bench::check(intf->query(QUERY_IDS[i], &value) && crtp.last == i, "query_router string routed to the wrong handler");
+
+    crtp.last = QUERY_ID_COUNT;
+    bench::check(intf->query(client.intern_query_id(QUERY_IDS[i]), &value) && crtp.last == i, "query_router token routed to the wrong handler");
+  }
+
+  for (const char * unknown : { "", "get_vtablf", "get_vtable_", "pars", "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz" })
+    bench::check(!intf->query(unknown, &value), "query_router answered an unknown ID");
+  bench::check(!intf->query(client.intern_query_id("unknown_query"), &value), "query_router answered an unknown token");
+
+  // Unrelated IDs interned in between spread the tokens too far for the dense array
+  bench::mock_client  sparse_client;
+  sdk::query_id       sparse_tokens[QUERY_ID_COUNT];
+  for (std::size_t i = 0; i < QUERY_ID_COUNT; ++i) {
+    sparse_tokens[i] = sparse_client.intern_query_id(QUERY_IDS[i]);
+    for (std::size_t j = 0; j < 8; ++j)
+      sparse_client.intern_query_id(("padding_" + std::to_string(i) + "_" + std::to_string(j)).c_str());
+  }
+
+  sdk::query_id_table<QUERY_ID_COUNT> sparse { QUERY_IDS };
+  sparse.intern(&sparse_client);
+  for (std::size_t i = 0; i < QUERY_ID_COUNT; ++i)
+    bench::check(sparse.find(sparse_tokens[i]) == i, "query_id_table sparse lookup found the wrong index");
+
+  bench::check(sparse.find(sparse_client.intern_query_id("padding_0_0")) == QUERY_ID_COUNT, "query_id_table sparse lookup matched an unknown token");
+  bench::check(sparse.find(sdk::query_id::INVALID) == QUERY_ID_COUNT, "query_id_table sparse lookup matched INVALID");
+}
+
+static auto bench_query(bench::mock_client & client) -> void {
+  check_query_routes(client);
+
+  router_module   router(&client);
+  sdk::sdk_intf * intf = &router;
+  int             value = 0;
+
+  bench::run("query string, first ID", 10000000, [&] {
+    bench::keep(intf->query(QUERY_IDS[0], &value));
+  });
+
+  bench::run("query string, last ID", 10000000, [&] {
+    bench::keep(intf->query(QUERY_IDS[QUERY_ID_COUNT - 1], &value));
+  });
+
+  const sdk::query_id first = client.intern_query_id(QUERY_IDS[0]);
+  const sdk::query_id last  = client.intern_query_id(QUERY_IDS[QUERY_ID_COUNT - 1]);
+
+  bench::run("query token, first ID", 10000000, [&] {
+    bench::keep(intf->query(first, &value));
+  });
+
+  bench::run("query token, last ID", 10000000, [&] {
+    bench::keep(intf->query(last, &value));
+  });
+
+  crtp_router_module crtp;
+  crtp.intern_queries(&client);
+  intf = &crtp;
+
+  bench::run("query_router string, first ID", 10000000, [&] {
+    bench::keep(intf->query(QUERY_IDS[0], &value));
+  });
+
+  bench::run("query_router string, last ID", 10000000, [&] {
+    bench::keep(intf->query(QUERY_IDS[QUERY_ID_COUNT - 1], &value));
+  });
+
+  bench::run("query_router token, last ID", 10000000, [&] {
+    bench::keep(intf->query(last, &value));
+  });
+}
+
+static auto bench_mcstr(bench::mock_client & client) -> void {
+  std::string          storage = "<steve> the quick brown fox jumps over the lazy dog";
+  sdk::managed_string * ms     = reinterpret_cast<sdk::managed_string *>(&storage);
+  const std::string    source  = storage;
+
+  bench::run("get_mcstr + strlen + set_mcstr", 1000000, [&] {
+    const char * str = client.get_mcstr(ms);
+    bench::keep(std::strlen(str));
+    client.set_mcstr(ms, source.c_str());
+  });
+
+  bench::run("get_mcstr_view + set_mcstr_n", 1000000, [&] {
+    sdk::mcstr_view view = client.get_mcstr_view(ms);
+    bench::keep(view.size);
+    client.set_mcstr(ms, source.data(), source.size());
+  });
+
+  bench::run("prefix with set_mcstr (rebuild)", 1000000, [&] {
+    std::string prefixed = "[Guild] ";
+    prefixed += client.get_mcstr(ms);
+    client.set_mcstr(ms, prefixed.c_str());
+    client.set_mcstr(ms, source.data(), source.size());
+  });
+
+  client.reserve_mcstr(ms, source.size() + 8);
+  bench::run("prefix with prepend_mcstr (in place)", 1000000, [&] {
+    client.prepend_mcstr(ms, "[Guild] ", 8);
+    client.set_mcstr(ms, source.data(), source.size());
+  });
+}
+
+static auto bench_allocator(bench::mock_client & client) -> void {
+  sdk::allocator_intf * alloc = client.get_allocator();
+
+  bench::run("std::vector<int> x64, default allocator", 100000, [&] {
+    std::vector<int> v;
+    for (int i = 0; i < 64; ++i)
+      v.push_back(i);
+    bench::keep(v.size());
+  });
+
+  std::size_t frames = 0;
+  bench::run("std::vector<int> x64, frame_allocator", 100000, [&] {
+    std::vector<int, sdk::frame_allocator<int>> v { sdk::frame_allocator<int>(alloc) };
+    for (int i = 0; i < 64; ++i)
+      v.push_back(i);
+    bench::keep(v.size());
+    if (++frames == 100) {
+      client.end_frame();
+      frames = 0;
+    }
+  });
+  client.end_frame();
+}
+
+static auto bench_storage(bench::mock_client & client) -> void {
+  struct settings {
+    std::uint32_t flags;
+    float         zoom;
+    char          prefix[8];
+  };
+
+  sdk::storage_intf * storage = client.get_storage();
+  settings            value   = { .flags = 1, .zoom = 2.0f, .prefix = "." };
+  storage->write(nullptr, "settings", value);
+
+  bench::run("storage read<T>", 1000000, [&] {
+    bench::keep(storage->read(nullptr, "settings", &value));
+  });
+
+  std::size_t writes = 0;
+  bench::run("storage write<T>", 1000000, [&] {
+    ++value.flags;
+    bench::keep(storage->write(nullptr, "settings", value));
+    if (++writes == 100) {
+      client.end_frame();
+      writes = 0;
+    }
+  });
+  client.end_frame();
+}
+
+static auto bench_channels(bench::mock_client & client) -> void {
+  static constexpr std::size_t CONSUMERS = 3;
+  static constexpr std::size_t BATCH     = 64; // Updates per tick
+
+  entity_update updates[BATCH] = {};
+  for (std::size_t i = 0; i < BATCH; ++i)
+    updates[i].entity = i;
+
+  entity_consumer consumers[CONSUMERS];
+  bench::run("3 consumers x 64 updates, query per update", 10000, [&] {
+    for (entity_update & u : updates)
+      for (sdk::sdk_intf * c : { static_cast<sdk::sdk_intf *>(&consumers[0]), static_cast<sdk::sdk_intf *>(&consumers[1]), static_cast<sdk::sdk_intf *>(&consumers[2]) })
+        bench::keep(c->query("push_entity", &u, sizeof(u)));
+  });
+
+  sdk::channel_intf *  channels = client.get_channels();
+  const sdk::channel_id channel = channels->create_channel<entity_update>(nullptr, 256, sdk::channel_mode::MPMC);
+
+  sdk::subscription_id subs[CONSUMERS];
+  for (sdk::subscription_id & sub : subs)
+    sub = channels->subscribe(nullptr, channel);
+
+  bench::run("3 consumers x 64 updates, channel batch", 10000, [&] {
+    channels->publish(channel, updates, BATCH);
+    for (sdk::subscription_id sub : subs)
+      channels->consume<entity_update>(sub, [](const entity_update & u) { bench::keep(u.entity); });
+  });
+
+  client.release_all(nullptr);
+}
+
+static auto bench_chat_history(bench::mock_client & client) -> void {
+  static constexpr const char * SENDERS[] = { "steve", "alex", "herobrine", "notch" };
+
+  char message[64];
+  for (std::size_t i = 0; i < client.chat_history_capacity(); ++i) {
+    std::snprintf(message, sizeof(message), "message number %zu from the server", i);
+    const sdk::event_chat_log e = {
+      .action       = sdk::event_action::NOTHING,
+      .message      = message,
+      .sender_name  = SENDERS[i % 4],
+      .context      = "",
+      .display_text = nullptr,
+    };
+    client.record_chat(&e, 1000 + i);
+  }
+
+  std::size_t found = 0;
+  const sdk::chat_history_query by_sender = { .after = 0, .since = 0, .until = 0, .sender = "notch", .sender_len = 5, .text = nullptr, .text_len = 0, .limit = 10, .newest_first = true };
+  bench::run("chat history, last 10 of a sender", 100000, [&] {
+    client.visit_chat_history(by_sender, [&](const sdk::chat_entry & e) { found += e.message.size; return true; });
+  });
+
+  const sdk::chat_history_query by_time = { .after = 0, .since = 1500, .until = 1515, .sender = nullptr, .sender_len = 0, .text = nullptr, .text_len = 0, .limit = 0, .newest_first = false };
+  bench::run("chat history, 16 entries of a time range", 100000, [&] {
+    client.visit_chat_history(by_time, [&](const sdk::chat_entry & e) { found += e.message.size; return true; });
+  });
+
+  const sdk::chat_history_query by_text = { .after = 0, .since = 0, .until = 0, .sender = nullptr, .sender_len = 0, .text = "number 1000 ", .text_len = 12, .limit = 0, .newest_first = false };
+  bench::run("chat history, substring over 1024 entries", 10000, [&] {
+    client.visit_chat_history(by_text, [&](const sdk::chat_entry & e) { found += e.message.size; return true; });
+  });
+
+  bench::keep(found);
+}
+
+static auto bench_tracing(bench::mock_client & client) -> void {
+  bench::run("scoped_trace, recorder disabled", 10000000, [&] {
+    sdk::scoped_trace trace(&client, "bench::scope");
+  });
+
+  const std::atomic<bool> * tracing = client.tracing_flag();
+  bench::run("scoped_trace with tracing_flag, recorder disabled", 10000000, [&] {
+    sdk::scoped_trace trace(&client, tracing, "bench::scope");
+  });
+
+  client.set_tracing(true);
+  bench::run("scoped_trace, recorder enabled", 1000000, [&] {
+    sdk::scoped_trace trace(&client, "bench::scope");
+  });
+  client.set_tracing(false);
+}
+
+auto main() -> int {
+  bench::mock_client client;
+
+  bench_listener_churn(client);
+  bench_dispatch(client);
+  bench_commands(client);
+  bench_query(client);
+  bench_mcstr(client);
+  bench_allocator(client);
+  bench_storage(client);
+  bench_channels(client);
+  bench_chat_history(client);
+  bench_tracing(client);
+
+  bench::keep(listener_calls);
+  return bench::failures ? 1 : 0;
+}
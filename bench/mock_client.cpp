@@ -0,0 +1,1025 @@
+#include "mock_client.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace bench {
+
+static constexpr std::size_t LOG_QUEUE_CAPACITY = 256;
+static constexpr std::size_t FRAME_ARENA_SIZE   = 1024 * 1024;
+static constexpr char        COMMAND_PREFIX     = '.';
+static constexpr std::size_t CHAT_HISTORY_SIZE  = 1024;
+
+static auto as_string(sdk::managed_string * ms) -> std::string * {
+  return reinterpret_cast<std::string *>(ms);
+}
+
+auto mock_scheduler::query(const char * id, void * ptr, std::uint64_t size) -> bool {
+  (void)id; (void)ptr; (void)size;
+  return false;
+}
+
+auto mock_scheduler::submit(sdk::plugin_intf * owner, task_fn fn, void * ctx) -> bool {
+  (void)owner;
+  fn(ctx);
+  return true;
+}
+
+auto mock_scheduler::parallel_for(std::size_t begin, std::size_t end, std::size_t grain, range_fn fn, void * ctx) -> bool {
+  if (begin < end)
+    fn(ctx, begin, end);
+  (void)grain;
+  return true;
+}
+
+auto mock_scheduler::run_on_game_thread(sdk::plugin_intf * owner, task_fn fn, void * ctx) -> bool {
+  this->game_thread_tasks.push_back(task { .owner = owner, .fn = fn, .ctx = ctx });
+  return true;
+}
+
+auto mock_scheduler::wait_idle(sdk::plugin_intf * owner) -> void {
+  // Tasks already ran inline, only the owner's continuations are left to run in place
+  for (;;) {
+    auto it = std::find_if(this->game_thread_tasks.begin(), this->game_thread_tasks.end(), [owner](const task & t) { return t.owner == owner; });
+    if (it == this->game_thread_tasks.end())
+      return;
+
+    const task t = *it;
+    this->game_thread_tasks.erase(it);
+    t.fn(t.ctx);
+  }
+}
+
+auto mock_scheduler::worker_count() -> std::size_t {
+  return 0;
+}
+
+auto mock_scheduler::run_game_thread_tasks() -> void {
+  std::vector<task> tasks;
+  tasks.swap(this->game_thread_tasks);
+  for (const task & t : tasks)
+    t.fn(t.ctx);
+}
+
+auto mock_scheduler::release(sdk::plugin_intf * owner) -> void {
+  std::erase_if(this->game_thread_tasks, [owner](const task & t) { return t.owner == owner; });
+}
+
+mock_allocator::mock_allocator() : arena(FRAME_ARENA_SIZE) {
+}
+
+auto mock_allocator::query(const char * id, void * ptr, std::uint64_t size) -> bool {
+  (void)id; (void)ptr; (void)size;
+  return false;
+}
+
+auto mock_allocator::frame_alloc(std::size_t size, std::size_t align) -> void * {
+  const std::uintptr_t base    = reinterpret_cast<std::uintptr_t>(this->arena.data());
+  const std::uintptr_t aligned = (base + this->arena_used + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+  if (aligned + size > base + this->arena.size())
+    return nullptr;
+
+  this->arena_used = aligned + size - base;
+  return reinterpret_cast<void *>(aligned);
+}
+
+auto mock_allocator::allocate(std::size_t size, std::size_t align) -> void * {
+  return ::operator new(size, std::align_val_t(align), std::nothrow);
+}
+
+auto mock_allocator::deallocate(void * ptr, std::size_t size, std::size_t align) -> void {
+  (void)size;
+  ::operator delete(ptr, std::align_val_t(align));
+}
+
+auto mock_allocator::reset_frame() -> void {
+  this->arena_used = 0;
+}
+
+auto mock_storage::query(const char * id, void * ptr, std::uint64_t size) -> bool {
+  (void)id; (void)ptr; (void)size;
+  return false;
+}
+
+auto mock_storage::read(sdk::plugin_intf * owner, const char * key, std::size_t key_len, sdk::storage_view * out) -> bool {
+  auto ns = this->namespaces.find(owner);
+  if (ns == this->namespaces.end())
+    return false;
+
+  auto it = ns->second.find(std::string_view(key, key_len));
+  if (it == ns->second.end())
+    return false;
+
+  *out = sdk::storage_view { .data = it->second->data(), .size = it->second->size() };
+  return true;
+}
+
+auto mock_storage::write(sdk::plugin_intf * owner, const char * key, std::size_t key_len, const void * data, std::size_t size) -> bool {
+  const unsigned char * bytes = static_cast<const unsigned char *>(data);
+  value                 entry = std::make_shared<const std::vector<unsigned char>>(bytes, bytes + size);
+
+  auto & ns = this->namespaces[owner];
+  auto   it = ns.find(std::string_view(key, key_len));
+  if (it == ns.end()) {
+    ns.emplace(std::string(key, key_len), std::move(entry));
+  } else {
+    this->retired.push_back(std::move(it->second));
+    it->second = std::move(entry);
+  }
+  return true;
+}
+
+auto mock_storage::erase(sdk::plugin_intf * owner, const char * key, std::size_t key_len) -> bool {
+  auto ns = this->namespaces.find(owner);
+  if (ns == this->namespaces.end())
+    return false;
+
+  auto it = ns->second.find(std::string_view(key, key_len));
+  if (it == ns->second.end())
+    return false;
+
+  this->retired.push_back(std::move(it->second));
+  ns->second.erase(it);
+  return true;
+}
+
+auto mock_storage::visit(sdk::plugin_intf * owner, const char * prefix, std::size_t prefix_len, visit_fn fn, void * ctx) -> void {
+  auto ns = this->namespaces.find(owner);
+  if (ns == this->namespaces.end())
+    return;
+
+  const std::string_view p(prefix, prefix_len);
+  for (auto it = ns->second.lower_bound(p); it != ns->second.end() && std::string_view(it->first).starts_with(p); ++it) {
+    if (!fn(ctx, it->first.data(), it->first.size(), sdk::storage_view { .data = it->second->data(), .size = it->second->size() }))
+      break;
+  }
+}
+
+auto mock_storage::flush(sdk::plugin_intf * owner) -> void {
+  (void)owner;
+}
+
+auto mock_storage::reset_frame() -> void {
+  this->retired.clear();
+}
+
+auto mock_channels::query(const char * id, void * ptr, std::uint64_t size) -> bool {
+  (void)id; (void)ptr; (void)size;
+  return false;
+}
+
+auto mock_channels::create_channel(sdk::plugin_intf * owner, const sdk::channel_desc * desc) -> sdk::channel_id {
+  if (!desc || !desc->name || !desc->payload_size || !desc->capacity || (desc->payload_align & (desc->payload_align - 1)))
+    return sdk::channel_id::INVALID;
+
+  if (this->open_channel(desc->name, desc->payload_size) != sdk::channel_id::INVALID)
+    return sdk::channel_id::INVALID;
+
+  std::size_t capacity = 1;
+  while (capacity < desc->capacity)
+    capacity <<= 1;
+
+  const std::size_t align = desc->payload_align ? desc->payload_align : 1;
+  auto ch = std::make_unique<channel>();
+  ch->owner        = owner;
+  ch->name         = desc->name;
+  ch->payload_size = desc->payload_size;
+  ch->stride       = (desc->payload_size + align - 1) & ~(align - 1);
+  ch->mask         = capacity - 1;
+  ch->mode         = desc->mode;
+  ch->ring.resize(capacity * ch->stride);
+
+  this->channels.push_back(std::move(ch));
+  return static_cast<sdk::channel_id>(this->channels.size());
+}
+
+auto mock_channels::open_channel(const char * name, std::size_t payload_size) -> sdk::channel_id {
+  for (std::size_t i = 0; i < this->channels.size(); ++i) {
+    const channel * ch = this->channels[i].get();
+    if (ch && ch->name == name)
+      return ch->payload_size == payload_size ? static_cast<sdk::channel_id>(i + 1) : sdk::channel_id::INVALID;
+  }
+  return sdk::channel_id::INVALID;
+}
+
+auto mock_channels::destroy_channel(sdk::plugin_intf * owner, sdk::channel_id id) -> bool {
+  channel * ch = this->find(id);
+  if (!ch || ch->owner != owner)
+    return false;
+
+  const std::size_t index = static_cast<std::size_t>(id) - 1;
+  for (auto & sub : this->subscriptions)
+    if (sub && sub->channel == index)
+      sub.reset();
+
+  this->channels[index].reset();
+  return true;
+}
+
+auto mock_channels::acquire_write(sdk::channel_id id, std::size_t count, sdk::channel_span * out) -> std::size_t {
+  channel * ch = this->find(id);
+  if (!ch)
+    return 0;
+
+  // The slowest subscription gates the publisher
+  const std::size_t    capacity = ch->mask + 1;
+  const std::uint64_t  free     = capacity - (ch->written - this->oldest_unread(static_cast<std::size_t>(id) - 1));
+  const std::size_t    position = static_cast<std::size_t>(ch->written & ch->mask);
+  const std::size_t    n        = std::min({ count, static_cast<std::size_t>(free), capacity - position });
+
+  *out = sdk::channel_span { .data = ch->ring.data() + position * ch->stride, .count = n, .stride = ch->stride, .payload_size = ch->payload_size, .sequence = ch->written };
+  return n;
+}
+
+auto mock_channels::commit_write(sdk::channel_id id, const sdk::channel_span * span, std::size_t count) -> bool {
+  channel * ch = this->find(id);
+  if (!ch || span->sequence != ch->written || count > span->count)
+    return false;
+
+  ch->written += count;
+  return true;
+}
+
+auto mock_channels::subscribe(sdk::plugin_intf * owner, sdk::channel_id id) -> sdk::subscription_id {
+  channel * ch = this->find(id);
+  if (!ch || (ch->mode == sdk::channel_mode::SPSC && ch->subscriptions))
+    return sdk::subscription_id::INVALID;
+
+  ++ch->subscriptions;
+  this->subscriptions.push_back(std::make_unique<subscription>(subscription {
+    .owner   = owner,
+    .channel = static_cast<std::size_t>(id) - 1,
+    .read    = ch->written,
+  }));
+  return static_cast<sdk::subscription_id>(this->subscriptions.size());
+}
+
+auto mock_channels::unsubscribe(sdk::subscription_id id) -> bool {
+  subscription * sub = this->find(id);
+  if (!sub)
+    return false;
+
+  --this->channels[sub->channel]->subscriptions;
+  this->subscriptions[static_cast<std::size_t>(id) - 1].reset();
+  return true;
+}
+
+auto mock_channels::acquire_read(sdk::subscription_id id, std::size_t max, sdk::channel_span * out) -> std::size_t {
+  subscription * sub = this->find(id);
+  if (!sub)
+    return 0;
+
+  channel *         ch       = this->channels[sub->channel].get();
+  const std::size_t position = static_cast<std::size_t>(sub->read & ch->mask);
+  const std::size_t n        = std::min({ max, static_cast<std::size_t>(ch->written - sub->read), ch->mask + 1 - position });
+
+  *out = sdk::channel_span { .data = ch->ring.data() + position * ch->stride, .count = n, .stride = ch->stride, .payload_size = ch->payload_size, .sequence = sub->read };
+  return n;
+}
+
+auto mock_channels::release_read(sdk::subscription_id id, const sdk::channel_span * span, std::size_t count) -> bool {
+  subscription * sub = this->find(id);
+  if (!sub || span->sequence != sub->read || count > span->count)
+    return false;
+
+  sub->read += count;
+  return true;
+}
+
+auto mock_channels::channel_payload_size(sdk::channel_id id) -> std::size_t {
+  const channel * ch = this->find(id);
+  return ch ? ch->payload_size : 0;
+}
+
+auto mock_channels::subscription_payload_size(sdk::subscription_id id) -> std::size_t {
+  const subscription * sub = this->find(id);
+  return sub ? this->channels[sub->channel]->payload_size : 0;
+}
+
+auto mock_channels::release(sdk::plugin_intf * owner) -> void {
+  for (std::size_t i = 0; i < this->subscriptions.size(); ++i)
+    if (this->subscriptions[i] && this->subscriptions[i]->owner == owner)
+      this->unsubscribe(static_cast<sdk::subscription_id>(i + 1));
+
+  for (std::size_t i = 0; i < this->channels.size(); ++i)
+    if (this->channels[i] && this->channels[i]->owner == owner)
+      this->destroy_channel(owner, static_cast<sdk::channel_id>(i + 1));
+}
+
+auto mock_channels::find(sdk::channel_id id) -> channel * {
+  const std::size_t index = static_cast<std::size_t>(id);
+  return index != 0 && index <= this->channels.size() ? this->channels[index - 1].get() : nullptr;
+}
+
+auto mock_channels::find(sdk::subscription_id id) -> subscription * {
+  const std::size_t index = static_cast<std::size_t>(id);
+  return index != 0 && index <= this->subscriptions.size() ? this->subscriptions[index - 1].get() : nullptr;
+}
+
+auto mock_channels::oldest_unread(std::size_t index) -> std::uint64_t {
+  std::uint64_t oldest = this->channels[index]->written;
+  for (const auto & sub : this->subscriptions)
+    if (sub && sub->channel == index)
+      oldest = std::min(oldest, sub->read);
+  return oldest;
+}
+
+mock_client::mock_client() {
+  for (sdk::event_id eid : {
+    sdk::event_chat_send::EVENT_UID,
+    sdk::event_chat_log::EVENT_UID,
+    sdk::event_plugin_load::EVENT_UID,
+    sdk::event_plugin_unload::EVENT_UID,
+    sdk::event_plugin_reload::EVENT_UID,
+    sdk::event_module_load::EVENT_UID,
+    sdk::event_module_unload::EVENT_UID,
+    sdk::event_plugin_release::EVENT_UID,
+    sdk::event_tick::EVENT_UID,
+    sdk::event_render::EVENT_UID,
+  }) {
+    this->slot_index.emplace(eid, this->slots.size());
+    this->slots.emplace_back();
+  }
+}
+
+auto mock_client::query(const char * id, void * ptr, std::uint64_t size) -> bool {
+  (void)id; (void)ptr; (void)size;
+  return false;
+}
+
+auto mock_client::register_module(sdk::plugin_intf * parent, sdk::module_intf * instance) -> bool {
+  if (!instance || std::find(this->modules.begin(), this->modules.end(), instance) != this->modules.end())
+    return false;
+
+  this->modules.push_back(instance);
+  this->module_parents.push_back(parent);
+  ++this->generation;
+  return true;
+}
+
+auto mock_client::unregister_module(sdk::module_intf * instance) -> bool {
+  auto it = std::find(this->modules.begin(), this->modules.end(), instance);
+  if (it == this->modules.end())
+    return false;
+
+  this->module_parents.erase(this->module_parents.begin() + (it - this->modules.begin()));
+  this->modules.erase(it);
+  ++this->generation;
+  return true;
+}
+
+auto mock_client::enumerate_plugins(sdk::plugin_intf * out, std::size_t * count) -> bool {
+  // The legacy signature can't be filled with pointers, only the count is reported
+  (void)out;
+  *count = this->plugins.size();
+  return out == nullptr;
+}
+
+auto mock_client::enumerate_modules(sdk::module_intf * out, std::size_t * count) -> bool {
+  (void)out;
+  *count = this->modules.size();
+  return out == nullptr;
+}
+
+auto mock_client::add_event_listener(const char * ename, void * fnp) -> bool {
+  return this->add_event_listener_prio(sdk::fnv1a(ename), fnp, sdk::event_priority::NORMAL);
+}
+
+auto mock_client::remove_event_listener(void * fnp) -> bool {
+  for (event_slot & slot : this->slots) {
+    auto it = std::find_if(slot.listeners.begin(), slot.listeners.end(), [fnp](const listener & l) { return l.fnp == fnp; });
+    if (it != slot.listeners.end()) {
+      this->detach(slot, it - slot.listeners.begin());
+      return true;
+    }
+
+    auto pit = std::find_if(slot.added.begin(), slot.added.end(), [fnp](const listener & l) { return l.fnp == fnp; });
+    if (pit != slot.added.end()) {
+      pit->fnp = nullptr;
+      pit->filters.reset();
+      ++slot.refs[pit->id].generation;
+      return true;
+    }
+
+    auto bit = std::find(slot.batch_listeners.begin(), slot.batch_listeners.end(), fnp);
+    if (bit != slot.batch_listeners.end()) {
+      slot.batch_listeners.erase(bit);
+      return true;
+    }
+
+    auto ait = std::find(slot.async_listeners.begin(), slot.async_listeners.end(), fnp);
+    if (ait != slot.async_listeners.end()) {
+      slot.async_listeners.erase(ait);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+auto mock_client::queue_log_chat(const char * text) -> bool {
+  return this->queue_log_chat_n(text, std::strlen(text), sdk::log_policy::DROP);
+}
+
+auto mock_client::get_mcstr(sdk::managed_string * ms) -> const char * {
+  return as_string(ms)->c_str();
+}
+
+auto mock_client::set_mcstr(sdk::managed_string * ms, const char * str) -> sdk::managed_string * {
+  as_string(ms)->assign(str);
+  return ms;
+}
+
+auto mock_client::add_event_listener_uid(sdk::event_id eid, void * fnp) -> bool {
+  return this->add_event_listener_prio(eid, fnp, sdk::event_priority::NORMAL);
+}
+
+auto mock_client::add_event_listener_prio(sdk::event_id eid, void * fnp, sdk::event_priority priority) -> bool {
+  return this->attach_event_listener(eid, fnp, priority) != sdk::listener_handle::INVALID;
+}
+
+auto mock_client::add_event_batch_listener(sdk::event_id eid, void * fnp) -> bool {
+  event_slot * slot = this->find_slot(eid);
+  if (!slot || !fnp)
+    return false;
+
+  slot->batch_listeners.push_back(fnp);
+  return true;
+}
+
+auto mock_client::get_mcstr_view(sdk::managed_string * ms) -> sdk::mcstr_view {
+  const std::string * str = as_string(ms);
+  return sdk::mcstr_view { .data = str->data(), .size = str->size() };
+}
+
+auto mock_client::set_mcstr_n(sdk::managed_string * ms, const char * str, std::size_t len) -> sdk::managed_string * {
+  as_string(ms)->assign(str, len);
+  return ms;
+}
+
+auto mock_client::reserve_mcstr(sdk::managed_string * ms, std::size_t capacity) -> sdk::managed_string * {
+  as_string(ms)->reserve(capacity);
+  return ms;
+}
+
+auto mock_client::append_mcstr(sdk::managed_string * ms, const char * str, std::size_t len) -> sdk::managed_string * {
+  as_string(ms)->append(str, len);
+  return ms;
+}
+
+auto mock_client::replace_mcstr(sdk::managed_string * ms, std::size_t pos, std::size_t count, const char * str, std::size_t len) -> sdk::managed_string * {
+  std::string * s = as_string(ms);
+  if (pos > s->size())
+    return nullptr;
+
+  s->replace(pos, count, str, len);
+  return ms;
+}
+
+auto mock_client::registry_generation() -> std::uint64_t {
+  return this->generation;
+}
+
+template <typename T>
+auto mock_client::acquire(std::vector<std::unique_ptr<snapshot_holder<T>>> & cache, const std::vector<T *> & items) -> const sdk::registry_snapshot<T> * {
+  if (cache.empty() || cache.back()->snapshot.generation != this->generation) {
+    auto holder   = std::make_unique<snapshot_holder<T>>();
+    holder->items = items;
+    holder->refs  = 0;
+    holder->snapshot = sdk::registry_snapshot<T> {
+      .generation = this->generation,
+      .count      = holder->items.size(),
+      .items      = holder->items.data(),
+    };
+    cache.push_back(std::move(holder));
+  }
+
+  ++cache.back()->refs;
+  return &cache.back()->snapshot;
+}
+
+template <typename T>
+auto mock_client::release(std::vector<std::unique_ptr<snapshot_holder<T>>> & cache, const sdk::registry_snapshot<T> * snapshot) -> void {
+  auto it = std::find_if(cache.begin(), cache.end(), [snapshot](const auto & h) { return &h->snapshot == snapshot; });
+  if (it == cache.end())
+    return;
+
+  // The current snapshot is kept around to be handed out again
+  if (--(*it)->refs == 0 && it + 1 != cache.end())
+    cache.erase(it);
+}
+
+auto mock_client::acquire_plugins() -> const sdk::plugin_snapshot * {
+  return this->acquire(this->plugin_snapshots, this->plugins);
+}
+
+auto mock_client::release_plugins(const sdk::plugin_snapshot * snapshot) -> void {
+  this->release(this->plugin_snapshots, snapshot);
+}
+
+auto mock_client::acquire_modules() -> const sdk::module_snapshot * {
+  return this->acquire(this->module_snapshots, this->modules);
+}
+
+auto mock_client::release_modules(const sdk::module_snapshot * snapshot) -> void {
+  this->release(this->module_snapshots, snapshot);
+}
+
+auto mock_client::intern_query_id(const char * id) -> sdk::query_id {
+  if (!id)
+    return sdk::query_id::INVALID;
+
+  auto [it, inserted] = this->query_ids.try_emplace(id, static_cast<sdk::query_id>(this->query_ids.size() + 1));
+  return it->second;
+}
+
+auto mock_client::queue_log_chat_n(const char * text, std::size_t len, sdk::log_policy policy) -> bool {
+  // Single threaded, BLOCK can't be waited out and behaves as DROP
+  if (this->log_queue.size() >= LOG_QUEUE_CAPACITY) {
+    if (policy == sdk::log_policy::COALESCE && this->log_queue.back().compare(0, std::string::npos, text, len) == 0)
+      return true;
+    return false;
+  }
+
+  this->log_queue.emplace_back(text, len);
+  return true;
+}
+
+auto mock_client::log_queue_capacity() -> std::size_t {
+  return LOG_QUEUE_CAPACITY;
+}
+
+auto mock_client::queue_log_chat_batch(const char * const * lines, std::size_t n, sdk::log_policy policy) -> bool {
+  (void)policy;
+  if (this->log_queue.size() + n > LOG_QUEUE_CAPACITY)
+    return false;
+
+  for (std::size_t i = 0; i < n; ++i)
+    this->log_queue.emplace_back(lines[i]);
+  return true;
+}
+
+auto mock_client::set_listener_profiling(bool enabled) -> bool {
+  // Profiling is not simulated
+  (void)enabled;
+  return false;
+}
+
+auto mock_client::enumerate_listener_profiles(sdk::listener_profile * out, std::size_t * count) -> bool {
+  (void)out;
+  *count = 0;
+  return true;
+}
+
+auto mock_client::reset_listener_profiles() -> void {
+}
+
+auto mock_client::add_event_listener_async(sdk::event_id eid, void * fnp) -> bool {
+  event_slot * slot = this->find_slot(eid);
+  if (!slot || !fnp)
+    return false;
+
+  slot->async_listeners.push_back(fnp);
+  return true;
+}
+
+auto mock_client::get_scheduler() -> sdk::scheduler_intf * {
+  return &this->scheduler;
+}
+
+auto mock_client::get_allocator() -> sdk::allocator_intf * {
+  return &this->allocator;
+}
+
+auto mock_client::reload_plugin(sdk::plugin_intf * instance, const char * path) -> bool {
+  // Plugins are not loaded by the mock
+  (void)instance; (void)path;
+  return false;
+}
+
+// Handle layout: slot index + 1 (16 bits) | generation (16 bits) | listener id (32 bits)
+auto mock_client::attach_event_listener(sdk::event_id eid, void * fnp, sdk::event_priority priority) -> sdk::listener_handle {
+  return this->insert(eid, listener { .priority = priority, .fnp = fnp, .ctx = nullptr, .has_ctx = false, .id = 0, .filters = nullptr });
+}
+
+auto mock_client::attach_event_listener_ctx(sdk::event_id eid, void * fnp, void * ctx, sdk::event_priority priority) -> sdk::listener_handle {
+  return this->insert(eid, listener { .priority = priority, .fnp = fnp, .ctx = ctx, .has_ctx = true, .id = 0, .filters = nullptr });
+}
+
+auto mock_client::attach_event_listener_filtered(sdk::event_id eid, void * fnp, void * ctx, sdk::event_priority priority, const sdk::event_filter * filters, std::size_t count) -> sdk::listener_handle {
+  auto set = std::make_shared<filter_set>();
+  for (std::size_t i = 0; i < count; ++i) {
+    const sdk::event_filter & f = filters[i];
+    const bool available = eid == sdk::event_chat_log::EVENT_UID
+                        || (eid == sdk::event_chat_send::EVENT_UID && f.field == sdk::filter_field::MESSAGE);
+    if (!available || (!f.pattern && f.length))
+      return sdk::listener_handle::INVALID;
+
+    compiled_filter & compiled = set->emplace_back();
+    compiled.field   = f.field;
+    compiled.kind    = f.kind;
+    compiled.pattern = f.length ? std::string(f.pattern, f.length) : std::string();
+
+    if (f.kind == sdk::filter_kind::REGEX) {
+      try {
+        compiled.regex = std::regex(compiled.pattern, std::regex::ECMAScript | std::regex::optimize);
+      } catch (const std::regex_error &) {
+        return sdk::listener_handle::INVALID;
+      }
+    }
+  }
+
+  return this->insert(eid, listener {
+    .priority = priority,
+    .fnp      = fnp,
+    .ctx      = ctx,
+    .has_ctx  = true,
+    .id       = 0,
+    .filters  = set->empty() ? nullptr : std::move(set),
+  });
+}
+
+auto mock_client::insert(sdk::event_id eid, const listener & entry) -> sdk::listener_handle {
+  auto found = this->slot_index.find(eid);
+  if (found == this->slot_index.end() || !entry.fnp)
+    return sdk::listener_handle::INVALID;
+
+  event_slot & slot = this->slots[found->second];
+
+  // Compacting early keeps attach/detach churn from growing the array, never while it's walked
+  if (slot.dirty && !slot.dispatching)
+    this->compact(slot);
+
+  std::uint32_t id = 0;
+  if (!slot.free_ids.empty()) {
+    id = slot.free_ids.back();
+    slot.free_ids.pop_back();
+  } else {
+    id = static_cast<std::uint32_t>(slot.refs.size());
+    slot.refs.push_back(listener_ref { .position = 0, .generation = 0 });
+  }
+
+  listener placed = entry;
+  placed.id = id;
+  if (slot.dispatching) {
+    slot.refs[id].position = PENDING;
+    slot.added.push_back(std::move(placed));
+  } else {
+    this->place(slot, placed);
+  }
+
+  return static_cast<sdk::listener_handle>(
+    (static_cast<std::uint64_t>(found->second + 1) << 48) |
+    (static_cast<std::uint64_t>(slot.refs[id].generation) << 32) |
+    id
+  );
+}
+
+auto mock_client::place(event_slot & slot, const listener & entry) -> void {
+  // Insert after every listener of the same priority to keep registration order
+  auto it = std::upper_bound(slot.listeners.begin(), slot.listeners.end(), entry.priority, [](sdk::event_priority p, const listener & l) { return p < l.priority; });
+  it = slot.listeners.insert(it, entry);
+
+  for (std::size_t i = it - slot.listeners.begin(); i < slot.listeners.size(); ++i)
+    slot.refs[slot.listeners[i].id].position = static_cast<std::uint32_t>(i);
+}
+
+auto mock_client::merge(event_slot & slot) -> void {
+  // Listeners detached before they were merged are dropped right away
+  for (const listener & l : slot.added) {
+    if (l.fnp)
+      this->place(slot, l);
+    else
+      slot.free_ids.push_back(l.id);
+  }
+  slot.added.clear();
+}
+
+auto mock_client::register_command(sdk::plugin_intf * owner, const char * name, sdk::command_fn fn, void * ctx) -> bool {
+  if (!name || !*name || !fn || std::strpbrk(name, " \t\"") || std::strcmp(name, "plug") == 0)
+    return false;
+
+  return this->commands.try_emplace(name, command { .owner = owner, .fn = fn, .ctx = ctx }).second;
+}
+
+auto mock_client::unregister_command(sdk::plugin_intf * owner, const char * name) -> bool {
+  auto it = this->commands.find(std::string_view(name));
+  if (it == this->commands.end() || it->second.owner != owner)
+    return false;
+
+  this->commands.erase(it);
+  return true;
+}
+
+auto mock_client::get_storage() -> sdk::storage_intf * {
+  return &this->storage;
+}
+
+auto mock_client::get_channels() -> sdk::channel_intf * {
+  return &this->channels;
+}
+
+auto mock_client::visit_chat_history(const sdk::chat_history_query * query, sdk::chat_visit_fn fn, void * ctx) -> std::size_t {
+  if (this->history.empty())
+    return 0;
+
+  const std::string_view text = query->text ? std::string_view(query->text, query->text_len) : std::string_view();
+
+  // Sequences are contiguous so an entry's index is its distance to the oldest one
+  const std::uint64_t oldest = this->history.front().sequence;
+  std::size_t         begin  = static_cast<std::size_t>(std::min<std::uint64_t>(std::max(query->after + 1, oldest) - oldest, this->history.size()));
+  std::size_t         end    = this->history.size();
+  if (query->since)
+    begin = std::max<std::size_t>(begin, std::partition_point(this->history.begin(), this->history.end(), [&](const history_entry & h) { return h.timestamp < query->since; }) - this->history.begin());
+  if (query->until)
+    end = std::partition_point(this->history.begin(), this->history.end(), [&](const history_entry & h) { return h.timestamp <= query->until; }) - this->history.begin();
+  if (begin >= end)
+    return 0;
+
+  std::size_t visited = 0;
+  auto visit = [&](std::size_t index) -> bool {
+    const history_entry & h = this->history[index];
+    if (query->text && h.message.find(text) == std::string::npos)
+      return true;
+
+    const sdk::chat_entry entry = {
+      .sequence    = h.sequence,
+      .timestamp   = h.timestamp,
+      .message     = sdk::mcstr_view { .data = h.message.data(),     .size = h.message.size()     },
+      .sender_name = sdk::mcstr_view { .data = h.sender_name.data(), .size = h.sender_name.size() },
+      .context     = sdk::mcstr_view { .data = h.context.data(),     .size = h.context.size()     },
+    };
+    ++visited;
+    return fn(ctx, &entry) && (!query->limit || visited < query->limit);
+  };
+
+  if (query->sender) {
+    auto found = this->history_senders.find(std::string_view(query->sender, query->sender_len));
+    if (found == this->history_senders.end())
+      return 0;
+
+    const std::deque<std::uint64_t> & sequences = found->second;
+    auto first = std::lower_bound(sequences.begin(), sequences.end(), oldest + begin);
+    auto last  = std::lower_bound(first, sequences.end(), oldest + end);
+    if (query->newest_first) {
+      while (last != first && visit(static_cast<std::size_t>(*--last - oldest)));
+    } else {
+      for (; first != last && visit(static_cast<std::size_t>(*first - oldest)); ++first);
+    }
+  } else if (query->newest_first) {
+    while (end != begin && visit(--end));
+  } else {
+    for (; begin != end && visit(begin); ++begin);
+  }
+  return visited;
+}
+
+auto mock_client::chat_history_capacity() -> std::size_t {
+  return CHAT_HISTORY_SIZE;
+}
+
+auto mock_client::record_chat(const sdk::event_chat_log * e, std::uint64_t timestamp) -> void {
+  if (this->history.size() == CHAT_HISTORY_SIZE) {
+    auto sender = this->history_senders.find(this->history.front().sender_name);
+    sender->second.pop_front();
+    if (sender->second.empty())
+      this->history_senders.erase(sender);
+    this->history.pop_front();
+  }
+
+  // Timestamps may not decrease along the sequence, the bounds are binary searched
+  if (!this->history.empty())
+    timestamp = std::max(timestamp, this->history.back().timestamp);
+
+  this->history.push_back(history_entry {
+    .sequence    = ++this->history_sequence,
+    .timestamp   = timestamp,
+    .message     = e->message     ? e->message     : "",
+    .sender_name = e->sender_name ? e->sender_name : "",
+    .context     = e->context     ? e->context     : "",
+  });
+  this->history_senders[this->history.back().sender_name].push_back(this->history_sequence);
+}
+
+auto mock_client::set_tracing(bool enabled) -> bool {
+  return this->tracing.exchange(enabled, std::memory_order_relaxed);
+}
+
+auto mock_client::tracing_flag() -> const std::atomic<bool> * {
+  return &this->tracing;
+}
+
+auto mock_client::export_trace(const char * path) -> bool {
+  std::FILE * file = std::fopen(path, "w");
+  if (!file)
+    return false;
+
+  std::fputs("{\"traceEvents\":[", file);
+
+  // Scopes end in reverse order, the name of an end is its matching begin's
+  std::vector<const char *> open;
+  bool                      first = true;
+  for (const trace_record & r : this->trace) {
+    const char * name = r.name;
+    if (name) {
+      open.push_back(name);
+    } else if (!open.empty()) {
+      name = open.back();
+      open.pop_back();
+    } else {
+      continue;
+    }
+
+    // Ends without a begin are skipped, the separator depends on what was written
+    std::fprintf(file, "%s{\"name\":\"", first ? "" : ",");
+    first = false;
+    for (const char * c = name; *c; ++c) {
+      if (*c == '"' || *c == '\\')
+        std::fputc('\\', file);
+      std::fputc(*c, file);
+    }
+    std::fprintf(file, "\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":1}", r.name ? 'B' : 'E', static_cast<double>(r.ns) / 1000.0);
+  }
+
+  std::fputs("]}\n", file);
+  return std::fclose(file) == 0;
+}
+
+auto mock_client::trace_begin(const char * name) -> void {
+  if (!this->tracing.load(std::memory_order_relaxed))
+    return;
+
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  this->trace.push_back(trace_record { .ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()), .name = name });
+}
+
+auto mock_client::trace_end() -> void {
+  if (!this->tracing.load(std::memory_order_relaxed))
+    return;
+
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  this->trace.push_back(trace_record { .ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()), .name = nullptr });
+}
+
+auto mock_client::route_command(sdk::event_chat_send * e) -> bool {
+  if (!e->message || this->commands.empty())
+    return false;
+
+  const sdk::mcstr_view message = this->get_mcstr_view(e->message);
+  if (message.size < 2 || message.data[0] != COMMAND_PREFIX)
+    return false;
+
+  const char * it  = message.data + 1;
+  const char * end = message.data + message.size;
+  const char * name_end = std::find_if(it, end, [](char c) { return c == ' ' || c == '\t'; });
+
+  auto found = this->commands.find(std::string_view(it, name_end - it));
+  if (found == this->commands.end())
+    return false;
+
+  it = std::find_if(name_end, end, [](char c) { return c != ' ' && c != '\t'; });
+  const sdk::mcstr_view raw = { .data = it, .size = static_cast<std::size_t>(end - it) };
+
+  this->command_argv.clear();
+  while (it != end) {
+    const char * arg_begin = it;
+    const char * arg_end   = nullptr;
+    if (*it == '"') {
+      arg_begin = it + 1;
+      arg_end   = std::find(arg_begin, end, '"');
+      it        = arg_end == end ? end : arg_end + 1;
+    } else {
+      arg_end = std::find_if(it, end, [](char c) { return c == ' ' || c == '\t'; });
+      it      = arg_end;
+    }
+
+    this->command_argv.push_back(sdk::mcstr_view { .data = arg_begin, .size = static_cast<std::size_t>(arg_end - arg_begin) });
+    it = std::find_if(it, end, [](char c) { return c != ' ' && c != '\t'; });
+  }
+
+  const sdk::command_args args = {
+    .name = sdk::mcstr_view { .data = message.data + 1, .size = static_cast<std::size_t>(name_end - message.data - 1) },
+    .argv = this->command_argv.data(),
+    .argc = this->command_argv.size(),
+    .raw  = raw,
+  };
+  found->second.fn(&args, found->second.ctx);
+  return true;
+}
+
+auto mock_client::detach_event_listener(sdk::listener_handle handle) -> bool {
+  const std::uint64_t   raw        = static_cast<std::uint64_t>(handle);
+  const std::size_t     index      = static_cast<std::size_t>(raw >> 48);
+  const std::uint16_t   generation = static_cast<std::uint16_t>(raw >> 32);
+  const std::uint32_t   id         = static_cast<std::uint32_t>(raw);
+
+  if (index == 0 || index > this->slots.size())
+    return false;
+
+  event_slot & slot = this->slots[index - 1];
+  if (id >= slot.refs.size() || slot.refs[id].generation != generation)
+    return false;
+
+  if (slot.refs[id].position == PENDING) {
+    auto it = std::find_if(slot.added.begin(), slot.added.end(), [id](const listener & l) { return l.id == id; });
+    it->fnp = nullptr;
+    it->filters.reset();
+    ++slot.refs[id].generation;
+    return true;
+  }
+
+  this->detach(slot, slot.refs[id].position);
+  return true;
+}
+
+auto mock_client::detach(event_slot & slot, std::size_t position) -> void {
+  listener & l = slot.listeners[position];
+  l.fnp = nullptr;
+  l.filters.reset();
+  ++slot.refs[l.id].generation;
+  slot.dirty = true;
+}
+
+auto mock_client::compact(event_slot & slot) -> void {
+  auto it = std::remove_if(slot.listeners.begin(), slot.listeners.end(), [&slot](const listener & l) {
+    if (l.fnp)
+      return false;
+    slot.free_ids.push_back(l.id);
+    return true;
+  });
+  slot.listeners.erase(it, slot.listeners.end());
+
+  for (std::size_t i = 0; i < slot.listeners.size(); ++i)
+    slot.refs[slot.listeners[i].id].position = static_cast<std::uint32_t>(i);
+  slot.dirty = false;
+}
+
+auto mock_client::release_all(sdk::plugin_intf * instance) -> bool {
+  // Listeners can't be attributed to a plugin image in process and are left in place
+  std::erase_if(this->commands, [instance](const auto & entry) { return entry.second.owner == instance; });
+  this->scheduler.release(instance);
+  this->channels.release(instance);
+
+  std::vector<sdk::module_intf *> released;
+  for (std::size_t i = 0; i < this->modules.size();) {
+    if (this->module_parents[i] == instance) {
+      released.push_back(this->modules[i]);
+      this->modules.erase(this->modules.begin() + i);
+      this->module_parents.erase(this->module_parents.begin() + i);
+    } else {
+      ++i;
+    }
+  }
+
+  if (!released.empty())
+    ++this->generation;
+
+  for (sdk::module_intf * mod : released) {
+    sdk::event_module_unload unload = {
+      .instance = instance,
+      .module   = mod,
+    };
+    this->dispatch(&unload);
+  }
+
+  sdk::event_plugin_release e = {
+    .instance     = instance,
+    .modules      = released.data(),
+    .module_count = released.size(),
+  };
+  this->dispatch(&e);
+  return true;
+}
+
+auto mock_client::end_frame() -> void {
+  this->scheduler.run_game_thread_tasks();
+
+  for (event_slot & slot : this->slots) {
+    if (slot.flush && !slot.pending.empty())
+      slot.flush(slot);
+    slot.pending.clear();
+
+    if (slot.dirty && !slot.dispatching)
+      this->compact(slot);
+  }
+
+  this->log_queue.clear();
+  this->allocator.reset_frame();
+  this->storage.reset_frame();
+}
+
+auto mock_client::listener_count(sdk::event_id eid) -> std::size_t {
+  event_slot * slot = this->find_slot(eid);
+  if (!slot)
+    return 0;
+  auto attached = [](const listener & l) { return l.fnp != nullptr; };
+  return std::count_if(slot->listeners.begin(), slot->listeners.end(), attached) + std::count_if(slot->added.begin(), slot->added.end(), attached);
+}
+
+auto mock_client::find_slot(sdk::event_id eid) -> event_slot * {
+  auto it = this->slot_index.find(eid);
+  return it != this->slot_index.end() ? &this->slots[it->second] : nullptr;
+}
+
+}
@@ -0,0 +1,468 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include <sdk/client_interface.hpp>
+
+namespace bench {
+
+/*
+ *  Scheduler without worker threads, tasks run inline and game thread
+ *  continuations are run by `mock_client::end_frame` or `wait_idle`.
+ *  Every call is treated as coming from the game thread.
+ */
+class mock_scheduler : public sdk::scheduler_intf {
+public:
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override;
+
+  auto submit(sdk::plugin_intf * owner, task_fn fn, void * ctx) -> bool override;
+  auto parallel_for(std::size_t begin, std::size_t end, std::size_t grain, range_fn fn, void * ctx) -> bool override;
+  auto run_on_game_thread(sdk::plugin_intf * owner, task_fn fn, void * ctx) -> bool override;
+  auto wait_idle(sdk::plugin_intf * owner) -> void override;
+  auto worker_count() -> std::size_t override;
+
+  using sdk::scheduler_intf::query;
+  using sdk::scheduler_intf::submit;
+  using sdk::scheduler_intf::run_on_game_thread;
+
+  auto run_game_thread_tasks() -> void;
+
+  /*
+   *  Drop the pending continuations of `owner`, see `release_all`
+   */
+  auto release(sdk::plugin_intf * owner) -> void;
+
+private:
+  struct task {
+    sdk::plugin_intf * owner;
+    task_fn            fn;
+    void             * ctx;
+  };
+
+  std::vector<task> game_thread_tasks;
+};
+
+/*
+ *  Allocator with a single bump allocated frame arena, the game thread's, reset by
+ *  `mock_client::end_frame` which stands for the end of a tick.
+ *  The pools are not simulated and go straight to the global heap.
+ */
+class mock_allocator : public sdk::allocator_intf {
+public:
+  mock_allocator();
+
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override;
+
+  auto frame_alloc(std::size_t size, std::size_t align) -> void * override;
+  auto allocate(std::size_t size, std::size_t align) -> void * override;
+  auto deallocate(void * ptr, std::size_t size, std::size_t align) -> void override;
+
+  using sdk::allocator_intf::query;
+
+  auto reset_frame() -> void;
+
+private:
+  std::vector<unsigned char> arena;
+  std::size_t                arena_used = 0;
+};
+
+/*
+ *  Storage kept in memory, nothing is written to disk
+ *  Overwritten values are retired until `mock_client::end_frame` so read views stay valid.
+ */
+class mock_storage : public sdk::storage_intf {
+public:
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override;
+
+  auto read(sdk::plugin_intf * owner, const char * key, std::size_t key_len, sdk::storage_view * out) -> bool override;
+  auto write(sdk::plugin_intf * owner, const char * key, std::size_t key_len, const void * data, std::size_t size) -> bool override;
+  auto erase(sdk::plugin_intf * owner, const char * key, std::size_t key_len) -> bool override;
+  auto visit(sdk::plugin_intf * owner, const char * prefix, std::size_t prefix_len, visit_fn fn, void * ctx) -> void override;
+  auto flush(sdk::plugin_intf * owner) -> void override;
+
+  using sdk::storage_intf::query;
+  using sdk::storage_intf::read;
+  using sdk::storage_intf::write;
+  using sdk::storage_intf::erase;
+
+  auto reset_frame() -> void;
+
+private:
+  using value = std::shared_ptr<const std::vector<unsigned char>>;
+
+  std::unordered_map<sdk::plugin_intf *, std::map<std::string, value, std::less<>>> namespaces;
+  std::vector<value>                                                                retired;
+};
+
+/*
+ *  Single threaded channels, SPSC and MPMC channels share the same ring
+ */
+class mock_channels : public sdk::channel_intf {
+public:
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override;
+
+  auto create_channel(sdk::plugin_intf * owner, const sdk::channel_desc * desc) -> sdk::channel_id override;
+  auto open_channel(const char * name, std::size_t payload_size) -> sdk::channel_id override;
+  auto destroy_channel(sdk::plugin_intf * owner, sdk::channel_id channel) -> bool override;
+  auto acquire_write(sdk::channel_id channel, std::size_t count, sdk::channel_span * out) -> std::size_t override;
+  auto commit_write(sdk::channel_id channel, const sdk::channel_span * span, std::size_t count) -> bool override;
+  auto subscribe(sdk::plugin_intf * owner, sdk::channel_id channel) -> sdk::subscription_id override;
+  auto unsubscribe(sdk::subscription_id subscription) -> bool override;
+  auto acquire_read(sdk::subscription_id subscription, std::size_t max, sdk::channel_span * out) -> std::size_t override;
+  auto release_read(sdk::subscription_id subscription, const sdk::channel_span * span, std::size_t count) -> bool override;
+  auto channel_payload_size(sdk::channel_id channel) -> std::size_t override;
+  auto subscription_payload_size(sdk::subscription_id subscription) -> std::size_t override;
+
+  using sdk::channel_intf::query;
+  using sdk::channel_intf::create_channel;
+  using sdk::channel_intf::open_channel;
+
+  auto release(sdk::plugin_intf * owner) -> void;
+
+private:
+  struct channel {
+    sdk::plugin_intf         * owner;
+    std::string                name;
+    std::size_t                payload_size;
+    std::size_t                stride;
+    std::size_t                mask;        // Capacity - 1
+    sdk::channel_mode          mode;
+    std::vector<unsigned char> ring;
+    std::uint64_t              written = 0; // Sequence of the next payload to publish
+    std::size_t                subscriptions = 0;
+  };
+
+  struct subscription {
+    sdk::plugin_intf * owner;
+    std::size_t        channel;             // Index into `channels`
+    std::uint64_t      read;                // Sequence of the next payload to read
+  };
+
+  auto find(sdk::channel_id id) -> channel *;
+  auto find(sdk::subscription_id id) -> subscription *;
+  auto oldest_unread(std::size_t index) -> std::uint64_t;
+
+  // Destroyed entries are left as nullptr so stale handles are never reused
+  std::vector<std::unique_ptr<channel>>      channels;
+  std::vector<std::unique_ptr<subscription>> subscriptions;
+};
+
+/*
+ *  Minimal in process implementation of `sdk::client_intf` used to measure the
+ *  cost of the SDK's calling conventions. Follows the dispatch design documented
+ *  in the SDK (flat per event arrays sorted by priority) but is single threaded.
+ *
+ *  `managed_string`s handed to the mock must point to an `std::string`.
+ */
+class mock_client : public sdk::client_intf {
+public:
+  mock_client();
+
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override;
+
+  auto register_module(sdk::plugin_intf * parent, sdk::module_intf * instance) -> bool override;
+  auto unregister_module(sdk::module_intf * instance) -> bool override;
+  auto enumerate_plugins(sdk::plugin_intf * out, std::size_t * count) -> bool override;
+  auto enumerate_modules(sdk::module_intf * out, std::size_t * count) -> bool override;
+  auto add_event_listener(const char * ename, void * fnp) -> bool override;
+  auto remove_event_listener(void * fnp) -> bool override;
+  auto queue_log_chat(const char * text) -> bool override;
+  auto get_mcstr(sdk::managed_string * ms) -> const char * override;
+  auto set_mcstr(sdk::managed_string * ms, const char * str) -> sdk::managed_string * override;
+  auto add_event_listener_uid(sdk::event_id eid, void * fnp) -> bool override;
+  auto add_event_listener_prio(sdk::event_id eid, void * fnp, sdk::event_priority priority) -> bool override;
+  auto add_event_batch_listener(sdk::event_id eid, void * fnp) -> bool override;
+  auto get_mcstr_view(sdk::managed_string * ms) -> sdk::mcstr_view override;
+  auto set_mcstr_n(sdk::managed_string * ms, const char * str, std::size_t len) -> sdk::managed_string * override;
+  auto reserve_mcstr(sdk::managed_string * ms, std::size_t capacity) -> sdk::managed_string * override;
+  auto append_mcstr(sdk::managed_string * ms, const char * str, std::size_t len) -> sdk::managed_string * override;
+  auto replace_mcstr(sdk::managed_string * ms, std::size_t pos, std::size_t count, const char * str, std::size_t len) -> sdk::managed_string * override;
+  auto registry_generation() -> std::uint64_t override;
+  auto acquire_plugins() -> const sdk::plugin_snapshot * override;
+  auto release_plugins(const sdk::plugin_snapshot * snapshot) -> void override;
+  auto acquire_modules() -> const sdk::module_snapshot * override;
+  auto release_modules(const sdk::module_snapshot * snapshot) -> void override;
+  auto intern_query_id(const char * id) -> sdk::query_id override;
+  auto queue_log_chat_n(const char * text, std::size_t len, sdk::log_policy policy) -> bool override;
+  auto log_queue_capacity() -> std::size_t override;
+  auto queue_log_chat_batch(const char * const * lines, std::size_t n, sdk::log_policy policy) -> bool override;
+  auto set_listener_profiling(bool enabled) -> bool override;
+  auto enumerate_listener_profiles(sdk::listener_profile * out, std::size_t * count) -> bool override;
+  auto reset_listener_profiles() -> void override;
+  auto add_event_listener_async(sdk::event_id eid, void * fnp) -> bool override;
+  auto get_scheduler() -> sdk::scheduler_intf * override;
+  auto get_allocator() -> sdk::allocator_intf * override;
+  auto reload_plugin(sdk::plugin_intf * instance, const char * path) -> bool override;
+  auto attach_event_listener(sdk::event_id eid, void * fnp, sdk::event_priority priority) -> sdk::listener_handle override;
+  auto detach_event_listener(sdk::listener_handle handle) -> bool override;
+  auto release_all(sdk::plugin_intf * instance) -> bool override;
+  auto attach_event_listener_ctx(sdk::event_id eid, void * fnp, void * ctx, sdk::event_priority priority) -> sdk::listener_handle override;
+  auto attach_event_listener_filtered(sdk::event_id eid, void * fnp, void * ctx, sdk::event_priority priority, const sdk::event_filter * filters, std::size_t count) -> sdk::listener_handle override;
+  auto register_command(sdk::plugin_intf * owner, const char * name, sdk::command_fn fn, void * ctx) -> bool override;
+  auto unregister_command(sdk::plugin_intf * owner, const char * name) -> bool override;
+  auto get_storage() -> sdk::storage_intf * override;
+  auto get_channels() -> sdk::channel_intf * override;
+  auto visit_chat_history(const sdk::chat_history_query * query, sdk::chat_visit_fn fn, void * ctx) -> std::size_t override;
+  auto chat_history_capacity() -> std::size_t override;
+  auto set_tracing(bool enabled) -> bool override;
+  auto export_trace(const char * path) -> bool override;
+  auto trace_begin(const char * name) -> void override;
+  auto trace_end() -> void override;
+  auto tracing_flag() -> const std::atomic<bool> * override;
+
+  using sdk::client_intf::query;
+  using sdk::client_intf::add_event_listener;
+  using sdk::client_intf::add_event_batch_listener;
+  using sdk::client_intf::add_event_listener_async;
+  using sdk::client_intf::attach_event_listener;
+  using sdk::client_intf::register_command;
+  using sdk::client_intf::visit_chat_history;
+  using sdk::client_intf::set_mcstr;
+  using sdk::client_intf::queue_log_chat_n;
+  using sdk::client_intf::queue_log_chat_batch;
+
+  /*
+   *  Dispatch an event through its listeners the way the client would
+   *  Returns the resulting action of the listener chain.
+   */
+  template <typename T>
+  auto dispatch(T * e) -> sdk::event_action {
+    event_slot * slot = this->find_slot(T::EVENT_UID);
+    if (!slot)
+      return sdk::event_action::NOTHING;
+
+    // Listeners attached or detached from inside the dispatch leave `listeners` untouched until it returns
+    ++slot->dispatching;
+
+    sdk::event_action result = sdk::event_action::NOTHING;
+    for (const listener & l : slot->listeners) {
+      if (!l.fnp || (l.filters && !this->matches(e, *l.filters)))
+        continue;
+
+      if (l.has_ctx)
+        reinterpret_cast<void(*)(T *, void *)>(l.fnp)(e, l.ctx);
+      else
+        reinterpret_cast<typename T::fn_t>(l.fnp)(e);
+
+      if constexpr (requires { e->action; }) {
+        if (e->action != sdk::event_action::NOTHING) {
+          result = e->action;
+          break;
+        }
+      }
+    }
+
+    // Commands are only routed once the listeners let the message through
+    if constexpr (std::is_same_v<T, sdk::event_chat_send>) {
+      if (result != sdk::event_action::CANCEL && this->route_command(e)) {
+        e->action = sdk::event_action::CANCEL;
+        result    = sdk::event_action::CANCEL;
+      }
+    }
+
+    // No worker threads, async listeners are called in place with a copy
+    for (std::size_t i = 0; i < slot->async_listeners.size(); ++i) {
+      T copy = *e;
+      reinterpret_cast<typename T::fn_t>(slot->async_listeners[i])(&copy);
+    }
+
+    if (--slot->dispatching == 0 && !slot->added.empty())
+      this->merge(*slot);
+
+    if constexpr (requires { typename T::batch_fn_t; }) {
+      if (!slot->batch_listeners.empty() && result != sdk::event_action::CANCEL) {
+        const std::size_t offset = slot->pending.size();
+        slot->pending.resize(offset + sizeof(T));
+        std::memcpy(slot->pending.data() + offset, e, sizeof(T));
+        slot->flush = +[](event_slot & s) {
+          for (void * fnp : s.batch_listeners)
+            reinterpret_cast<typename T::batch_fn_t>(fnp)(reinterpret_cast<T *>(s.pending.data()), s.pending.size() / sizeof(T));
+        };
+      }
+    }
+
+    return result;
+  }
+
+  /*
+   *  Delivers the pending batches and drains the chat log queue
+   *  NOTE: Batched items are copied as is, pointers inside them must outlive the frame.
+   */
+  auto end_frame() -> void;
+
+  auto listener_count(sdk::event_id eid) -> std::size_t;
+
+  /*
+   *  Add an entry to the chat history, dispatching `event_chat_log` does not
+   */
+  auto record_chat(const sdk::event_chat_log * e, std::uint64_t timestamp) -> void;
+
+private:
+  struct compiled_filter {
+    sdk::filter_field field;
+    sdk::filter_kind  kind;
+    std::string       pattern;
+    std::regex        regex;
+  };
+
+  // Filters are evaluated one listener at a time, prefixes are not merged
+  using filter_set = std::vector<compiled_filter>;
+
+  struct listener {
+    sdk::event_priority               priority;
+    void                            * fnp;      // nullptr once detached until the slot is compacted
+    void                            * ctx;
+    bool                              has_ctx;
+    std::uint32_t                     id;
+    std::shared_ptr<const filter_set> filters;  // nullptr when unfiltered
+  };
+
+  struct listener_ref {
+    std::uint32_t position;   // Index into `event_slot::listeners`
+    std::uint16_t generation; // Incremented on detach to catch stale handles
+  };
+
+  // `listener_ref::position` of a listener waiting in `event_slot::added`
+  static constexpr std::uint32_t PENDING = UINT32_MAX;
+
+  struct event_slot {
+    std::vector<listener>      listeners;       // Sorted by priority, registration order within a priority
+    std::vector<listener>      added;           // Attached while dispatching, merged once the dispatch returns
+    std::vector<listener_ref>  refs;            // Indexed by listener id
+    std::vector<std::uint32_t> free_ids;
+    std::uint32_t              dispatching = 0; // Depth of nested dispatches of the event
+    bool                       dirty = false;   // Has detached entries to compact at the end of the frame
+    std::vector<void *>    batch_listeners;
+    std::vector<void *>    async_listeners;
+    std::vector<char>      pending;         // Raw copies of the items of the current frame's batch
+    void                (* flush)(event_slot &) = nullptr;
+  };
+
+  template <typename T>
+  struct snapshot_holder {
+    sdk::registry_snapshot<T> snapshot;
+    std::vector<T *>          items;
+    std::size_t               refs;
+  };
+
+  template <typename T>
+  auto field_value(T * e, sdk::filter_field field) -> std::string_view {
+    if constexpr (std::is_same_v<T, sdk::event_chat_send>) {
+      if (field == sdk::filter_field::MESSAGE && e->message) {
+        const sdk::mcstr_view view = this->get_mcstr_view(e->message);
+        return std::string_view(view.data, view.size);
+      }
+    } else if constexpr (std::is_same_v<T, sdk::event_chat_log>) {
+      const char * str = field == sdk::filter_field::MESSAGE     ? e->message
+                       : field == sdk::filter_field::SENDER_NAME ? e->sender_name
+                       :                                           e->context;
+      if (str)
+        return std::string_view(str);
+    }
+    (void)e; (void)field;
+    return std::string_view();
+  }
+
+  template <typename T>
+  auto matches(T * e, const filter_set & filters) -> bool {
+    for (const compiled_filter & f : filters) {
+      const std::string_view value = this->field_value(e, f.field);
+      switch (f.kind) {
+      case sdk::filter_kind::PREFIX:
+        if (!value.starts_with(f.pattern))
+          return false;
+        break;
+      case sdk::filter_kind::EXACT:
+        if (value != f.pattern)
+          return false;
+        break;
+      case sdk::filter_kind::REGEX:
+        if (!std::regex_search(value.begin(), value.end(), f.regex))
+          return false;
+        break;
+      }
+    }
+    return true;
+  }
+
+  auto route_command(sdk::event_chat_send * e) -> bool;
+  auto find_slot(sdk::event_id eid) -> event_slot *;
+  auto insert(sdk::event_id eid, const listener & entry) -> sdk::listener_handle;
+  auto place(event_slot & slot, const listener & entry) -> void;
+  auto merge(event_slot & slot) -> void;
+  auto detach(event_slot & slot, std::size_t position) -> void;
+  auto compact(event_slot & slot) -> void;
+
+  template <typename T>
+  auto acquire(std::vector<std::unique_ptr<snapshot_holder<T>>> & cache, const std::vector<T *> & items) -> const sdk::registry_snapshot<T> *;
+
+  template <typename T>
+  auto release(std::vector<std::unique_ptr<snapshot_holder<T>>> & cache, const sdk::registry_snapshot<T> * snapshot) -> void;
+
+  std::unordered_map<sdk::event_id, std::size_t> slot_index;
+  std::vector<event_slot>                         slots;
+
+  std::vector<sdk::plugin_intf *>  plugins;
+  std::vector<sdk::module_intf *>  modules;
+  std::vector<sdk::plugin_intf *>  module_parents; // Parallel to `modules`
+  std::uint64_t                    generation = 0;
+
+  std::vector<std::unique_ptr<snapshot_holder<sdk::plugin_intf>>> plugin_snapshots; // Last entry is the current snapshot
+  std::vector<std::unique_ptr<snapshot_holder<sdk::module_intf>>> module_snapshots;
+
+  std::unordered_map<std::string, sdk::query_id> query_ids;
+
+  struct command {
+    sdk::plugin_intf * owner;
+    sdk::command_fn    fn;
+    void             * ctx;
+  };
+
+  // Ordered lookup instead of the client's trie, the prefix is fixed to '.'
+  std::map<std::string, command, std::less<>> commands;
+  std::vector<sdk::mcstr_view>                command_argv; // Reused between messages
+
+  struct history_entry {
+    std::uint64_t sequence;
+    std::uint64_t timestamp;
+    std::string   message;
+    std::string   sender_name;
+    std::string   context;
+  };
+
+  // Flat strings, nothing is interned. Bounds are binary searched and senders indexed
+  // as the SDK requires, `text` is compared linearly over what they select.
+  std::deque<history_entry>                                      history;
+  std::map<std::string, std::deque<std::uint64_t>, std::less<>> history_senders; // Sequences of each sender's entries, oldest first
+  std::uint64_t                                                  history_sequence = 0;
+
+  struct trace_record {
+    std::uint64_t   ns;
+    const char    * name;   // nullptr for the end of a scope
+  };
+
+  // Single thread and unbounded, only the scopes given to `trace_begin` are recorded
+  std::vector<trace_record> trace;
+  std::atomic<bool>         tracing = false;
+
+  std::vector<std::string> log_queue;
+
+  mock_scheduler scheduler;
+  mock_allocator allocator;
+  mock_storage   storage;
+  mock_channels  channels;
+};
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+
+#include "sdk_interface.hpp"
+
+namespace sdk {
+
+/*
+ *  Interface to the Client's memory allocator
+ *  Obtained through `client_intf::get_allocator`.
+ *
+ *  Memory handed out is owned by the client and not by a plugin's CRT heap, it
+ *  can be passed between plugins and freed by any of them. All functions are
+ *  thread safe.
+ */
+class allocator_intf : public sdk::sdk_intf {
+public:
+  /*
+   *  Allocate temporary memory from the calling thread's frame arena
+   *
+   *  Arena memory is never freed individually. Each thread's arena is reset by that
+   *  thread only, at its own reset point:
+   *  - The game thread's after every tick, once its events and continuations ran
+   *  - The render thread's after `event_render`
+   *  - A worker's between two tasks, so a task's memory lasts for as long as the
+   *    task does even when it spans several ticks
+   *  Do not keep pointers to it past the event or task that allocated it.
+   *  Returns nullptr if the arena is exhausted.
+   */
+  virtual auto frame_alloc(std::size_t size, std::size_t align) -> void * = 0;
+
+  /*
+   *  Allocate long lived memory
+   *
+   *  Small sizes are served from per size class pools, larger sizes fall back to
+   *  the client's heap. Free using `deallocate` with the same `size` and `align`.
+   */
+  virtual auto allocate(std::size_t size, std::size_t align) -> void * = 0;
+
+  /*
+   *  Free memory obtained from `allocate`
+   */
+  virtual auto deallocate(void * ptr, std::size_t size, std::size_t align) -> void = 0;
+};
+
+/*
+ *  Standard library allocator backed by the calling thread's frame arena
+ *  EXAMPLE:
+ *    std::vector<int, sdk::frame_allocator<int>> tmp { sdk::frame_allocator<int>(alloc) };
+ */
+template <typename T>
+class frame_allocator {
+public:
+  using value_type = T;
+
+  explicit frame_allocator(allocator_intf * alloc) noexcept : alloc(alloc) {}
+
+  template <typename U>
+  frame_allocator(const frame_allocator<U> & other) noexcept : alloc(other.get()) {}
+
+  auto allocate(std::size_t n) -> T * {
+    void * ptr = this->alloc->frame_alloc(n * sizeof(T), alignof(T));
+    if (!ptr)
+      throw std::bad_alloc();
+    return static_cast<T *>(ptr);
+  }
+
+  // Reclaimed when the arena is reset
+  auto deallocate(T *, std::size_t) noexcept -> void {}
+
+  auto get() const noexcept -> allocator_intf * { return this->alloc; }
+
+  template <typename U>
+  auto operator==(const frame_allocator<U> & other) const noexcept -> bool { return this->alloc == other.get(); }
+
+private:
+  allocator_intf * alloc;
+};
+
+/*
+ *  Standard library allocator backed by the client's size class pools
+ */
+template <typename T>
+class pool_allocator {
+public:
+  using value_type = T;
+
+  explicit pool_allocator(allocator_intf * alloc) noexcept : alloc(alloc) {}
+
+  template <typename U>
+  pool_allocator(const pool_allocator<U> & other) noexcept : alloc(other.get()) {}
+
+  auto allocate(std::size_t n) -> T * {
+    void * ptr = this->alloc->allocate(n * sizeof(T), alignof(T));
+    if (!ptr)
+      throw std::bad_alloc();
+    return static_cast<T *>(ptr);
+  }
+
+  auto deallocate(T * ptr, std::size_t n) noexcept -> void {
+    this->alloc->deallocate(ptr, n * sizeof(T), alignof(T));
+  }
+
+  auto get() const noexcept -> allocator_intf * { return this->alloc; }
+
+  template <typename U>
+  auto operator==(const pool_allocator<U> & other) const noexcept -> bool { return this->alloc == other.get(); }
+
+private:
+  allocator_intf * alloc;
+};
+
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "sdk_interface.hpp"
+#include "plugin_interface.hpp"
+
+namespace sdk {
+
+enum class channel_id      : std::uint64_t { INVALID = 0 };
+enum class subscription_id : std::uint64_t { INVALID = 0 };
+
+enum class channel_mode : std::uint32_t {
+  SPSC = 0, // A single publishing thread and a single subscription, no atomics on the hot path
+  MPMC = 1, // Any number of publishing threads and subscriptions
+};
+
+/*
+ *  Layout of a channel, see `channel_intf::create_channel`
+ */
+struct channel_desc {
+  const char   * name;
+  std::size_t    payload_size;  // Size of a single payload, every payload of a channel has the same layout
+  std::size_t    payload_align;
+  std::size_t    capacity;      // Number of payloads in the ring, rounded up to a power of two
+  channel_mode   mode;
+};
+
+/*
+ *  Contiguous run of payloads inside a channel's ring
+ */
+struct channel_span {
+  void        * data;
+  std::size_t   count;
+  std::size_t   stride;       // Distance in bytes between payloads
+  std::size_t   payload_size; // The channel's `channel_desc::payload_size`, at most `stride`
+  std::uint64_t sequence;     // Sequence number of the first payload
+};
+
+/*
+ *  Interface to the Client's publish/subscribe channels
+ *  Obtained through `client_intf::get_channels`.
+ *
+ *  A channel is a named ring buffer of fixed layout payloads. Publishers write
+ *  payloads in place and every subscription reads each payload in place, nothing
+ *  is copied by the client. A publisher can't overwrite payloads a subscription
+ *  has not released yet, a full ring makes `acquire_write` return fewer payloads.
+ *
+ *  Channels are owned by the plugin that created them and are destroyed along with
+ *  its subscriptions by `release_all`, handles to them become stale and every
+ *  function fails on a stale handle.
+ */
+class channel_intf : public sdk::sdk_intf {
+public:
+  /*
+   *  Create a channel owned by `owner`, fails if the name is taken
+   */
+  virtual auto create_channel(plugin_intf * owner, const channel_desc * desc) -> channel_id = 0;
+
+  /*
+   *  Find a channel by name, fails if the payload size does not match the channel's
+   */
+  virtual auto open_channel(const char * name, std::size_t payload_size) -> channel_id = 0;
+
+  /*
+   *  Destroy a channel created by `owner`, its subscriptions become stale
+   */
+  virtual auto destroy_channel(plugin_intf * owner, channel_id channel) -> bool = 0;
+
+  /*
+   *  Reserve up to `count` payloads to write, returns the number reserved in `out`
+   *
+   *  The span may be shorter than asked at the end of the ring, commit it and
+   *  reserve again for the rest. Payloads become visible on `commit_write`.
+   */
+  virtual auto acquire_write(channel_id channel, std::size_t count, channel_span * out) -> std::size_t = 0;
+
+  /*
+   *  Publish `count` payloads from the start of the span obtained from `acquire_write`
+   *
+   *  Every reservation has to be committed, an open one in an `MPMC` channel holds
+   *  back the commits of every later publisher. Committing fewer payloads than
+   *  reserved, 0 included, gives the rest of the reservation back.
+   */
+  virtual auto commit_write(channel_id channel, const channel_span * span, std::size_t count) -> bool = 0;
+
+  /*
+   *  Subscribe `owner` to a channel, the subscription starts at the next payload published
+   *  An `SPSC` channel only accepts a single subscription.
+   */
+  virtual auto subscribe(plugin_intf * owner, channel_id channel) -> subscription_id = 0;
+
+  virtual auto unsubscribe(subscription_id subscription) -> bool = 0;
+
+  /*
+   *  Obtain up to `max` unread payloads of a subscription, returns the number obtained in `out`
+   *  The payloads stay valid until they are released.
+   */
+  virtual auto acquire_read(subscription_id subscription, std::size_t max, channel_span * out) -> std::size_t = 0;
+
+  /*
+   *  Release `count` payloads from the start of the span obtained from `acquire_read`
+   *  Payloads that are not released are obtained again by the next `acquire_read`.
+   */
+  virtual auto release_read(subscription_id subscription, const channel_span * span, std::size_t count) -> bool = 0;
+
+  /*
+   *  Payload size of a channel, 0 for a stale handle
+   *  Check it before reserving instead of reading `channel_span::payload_size` after.
+   */
+  virtual auto channel_payload_size(channel_id channel) -> std::size_t = 0;
+
+  /*
+   *  Payload size of the channel a subscription reads, 0 for a stale handle
+   */
+  virtual auto subscription_payload_size(subscription_id subscription) -> std::size_t = 0;
+
+  // -------------------------------------------------------------------------------------------
+  // -- Helpers
+
+  /*
+   *  Create a channel for the payload type `T`, the name is given by `T::CHANNEL_ID`
+   *  EXAMPLE:
+   *    struct entity_update {
+   *      static constexpr const char CHANNEL_ID[] = "radar_entities";
+   *      ...
+   *    };
+   *
+   *    sdk::channel_id ch = channels->create_channel<entity_update>(mypluginst, 1024, sdk::channel_mode::MPMC);
+   */
+  template <typename T>
+  auto create_channel(plugin_intf * owner, std::size_t capacity, channel_mode mode) -> channel_id {
+    static_assert(requires { T::CHANNEL_ID; },     "Payload type parameter T must provide a CHANNEL_ID.");
+    static_assert(std::is_trivially_copyable_v<T>, "Payload types must be trivially copyable.");
+
+    const channel_desc desc = {
+      .name          = T::CHANNEL_ID,
+      .payload_size  = sizeof(T),
+      .payload_align = alignof(T),
+      .capacity      = capacity,
+      .mode          = mode,
+    };
+    return this->create_channel(owner, &desc);
+  }
+
+  template <typename T>
+  auto open_channel() -> channel_id {
+    static_assert(requires { T::CHANNEL_ID; }, "Payload type parameter T must provide a CHANNEL_ID.");
+    return this->open_channel(T::CHANNEL_ID, sizeof(T));
+  }
+
+  /*
+   *  Copy `count` payloads into a channel, returns the number published
+   *  Publishes nothing if the channel's payload size is not `sizeof(T)`.
+   *  Prefer writing in place through `acquire_write` when building payloads.
+   */
+  template <typename T>
+  auto publish(channel_id channel, const T * items, std::size_t count) -> std::size_t {
+    static_assert(requires { T::CHANNEL_ID; },     "Payload type parameter T must provide a CHANNEL_ID.");
+    static_assert(std::is_trivially_copyable_v<T>, "Payload types must be trivially copyable.");
+
+    // Checked up front, a span reserved and then abandoned would stall other publishers
+    if (this->channel_payload_size(channel) != sizeof(T))
+      return 0;
+
+    std::size_t published = 0;
+    while (published < count) {
+      channel_span span;
+      const std::size_t n = this->acquire_write(channel, count - published, &span);
+      if (n == 0)
+        break;
+
+      if (span.stride == sizeof(T)) {
+        std::memcpy(span.data, items + published, n * sizeof(T));
+      } else {
+        for (std::size_t i = 0; i < n; ++i)
+          std::memcpy(static_cast<char *>(span.data) + i * span.stride, items + published + i, sizeof(T));
+      }
+
+      if (!this->commit_write(channel, &span, n))
+        break;
+      published += n;
+    }
+    return published;
+  }
+
+  /*
+   *  Call `fn` with every unread payload of a subscription and release them
+   *  Returns the number of payloads read, reads nothing if the channel's payload
+   *  size is not `sizeof(T)`.
+   *  EXAMPLE:
+   *    channels->consume<entity_update>(sub, [](const entity_update & u) { ... });
+   */
+  template <typename T, typename F>
+  auto consume(subscription_id subscription, F && fn, std::size_t max = static_cast<std::size_t>(-1)) -> std::size_t {
+    static_assert(requires { T::CHANNEL_ID; },     "Payload type parameter T must provide a CHANNEL_ID.");
+    static_assert(std::is_trivially_copyable_v<T>, "Payload types must be trivially copyable.");
+
+    if (this->subscription_payload_size(subscription) != sizeof(T))
+      return 0;
+
+    std::size_t read = 0;
+    while (read < max) {
+      channel_span span;
+      const std::size_t n = this->acquire_read(subscription, max - read, &span);
+      if (n == 0)
+        break;
+
+      for (std::size_t i = 0; i < n; ++i)
+        fn(*reinterpret_cast<const T *>(static_cast<const char *>(span.data) + i * span.stride));
+
+      read += n;
+      if (!this->release_read(subscription, &span, n))
+        break;
+    }
+    return read;
+  }
+
+  // -- End of Helpers
+  // -------------------------------------------------------------------------------------------
+};
+
+}
@@ -3,12 +3,18 @@
 #include <cstdint>
 #include <cstddef>
 #include <type_traits>
+#include <atomic>
+#include <memory>
 
 #include "types.hpp"
 
 #include "sdk_interface.hpp"
 #include "module_interface.hpp"
 #include "plugin_interface.hpp"
+#include "scheduler_interface.hpp"
+#include "allocator_interface.hpp"
+#include "storage_interface.hpp"
+#include "channel_interface.hpp"
 
 namespace sdk {
 
@@ -17,11 +23,61 @@ struct ver_info {
   int minor;
 };
 
-inline const ver_info version = {
-  .major = 1, // Updated when breaking changes are introduced (VF index changes, parameter type changes, API changes, etc...)
-  .minor = 0, // Updated when non breaking changes are made (Addition of API, backend changes)
+/*
+ *  Version of the SDK, bumped once per release of the SDK and not per addition
+ *
+ *  A release with any breaking change bumps the major version and resets the minor,
+ *  any other release bumps the minor. Functions appended to an interface and new
+ *  events are not versioned one by one, use `client_caps` to detect them. Anything
+ *  without a `client_caps` bit is backed by every client of at least the version
+ *  that released it.
+ */
+inline constexpr ver_info version = {
+  .major = 1, // Updated when a release introduces breaking changes (VF index changes, parameter type changes, API changes, etc...)
+  .minor = 1, // Updated when a release only makes non breaking changes (Addition of API, backend changes)
 };
 
+/*
+ *  Optional services a client provides, given through `load_info::capabilities`
+ *
+ *  The interface functions of a service are always present but the client may not
+ *  back them (ie. `get_scheduler` returning nullptr). Check the capabilities once at
+ *  load time to pick your code paths instead of probing at runtime.
+ */
+enum class client_caps : std::uint64_t {
+  NONE               = 0,
+  LISTENER_PRIORITY  = 1ull << 0,  // `add_event_listener_prio`
+  BATCH_LISTENERS    = 1ull << 1,  // `add_event_batch_listener`
+  ASYNC_LISTENERS    = 1ull << 2,  // `add_event_listener_async`
+  MCSTR_EDIT         = 1ull << 3,  // In place `managed_string` editing (`reserve_mcstr`, `append_mcstr`, `replace_mcstr`)
+  REGISTRY_SNAPSHOTS = 1ull << 4,  // `acquire_plugins`, `acquire_modules`
+  QUERY_TOKENS       = 1ull << 5,  // `intern_query_id`
+  LOG_QUEUE_POLICY   = 1ull << 6,  // `queue_log_chat_n`, `queue_log_chat_batch`
+  LISTENER_PROFILING = 1ull << 7,  // `set_listener_profiling`
+  SCHEDULER          = 1ull << 8,  // `get_scheduler`
+  ALLOCATOR          = 1ull << 9,  // `get_allocator`
+  TICK_EVENTS        = 1ull << 10, // `event_tick`, `event_render`
+  HOT_RELOAD         = 1ull << 11, // `reload_plugin`
+  MANIFEST           = 1ull << 12, // `plugin_manifest`, see manifest.hpp
+  EVENT_FILTERS      = 1ull << 13, // `attach_event_listener_filtered`
+  COMMANDS           = 1ull << 14, // `register_command`
+  STORAGE            = 1ull << 15, // `get_storage`
+  CHANNELS           = 1ull << 16, // `get_channels`
+  CHAT_HISTORY       = 1ull << 17, // `visit_chat_history`
+  TRACING            = 1ull << 18, // `set_tracing`, `trace_begin`, `tracing_flag`
+  LISTENER_HANDLES   = 1ull << 19, // `attach_event_listener`, `detach_event_listener`
+  RELEASE_ALL        = 1ull << 20, // `release_all`, `event_plugin_release`
+  CONTEXT_LISTENERS  = 1ull << 21, // `attach_event_listener_ctx` and the member function helpers
+};
+
+constexpr auto operator|(client_caps lhs, client_caps rhs) -> client_caps {
+  return static_cast<client_caps>(static_cast<std::uint64_t>(lhs) | static_cast<std::uint64_t>(rhs));
+}
+
+constexpr auto operator&(client_caps lhs, client_caps rhs) -> client_caps {
+  return static_cast<client_caps>(static_cast<std::uint64_t>(lhs) & static_cast<std::uint64_t>(rhs));
+}
+
 // ---------------------------------------------------------------------------------------------------- 
 // -- EVENTS
 
@@ -31,14 +87,32 @@ enum class event_action : std::uint32_t {
   COMMIT  = 2, // Immediately lets the event to reach the game skipping the rest of the listeners upon the listener's return
 };
 
+/*
+ *  Order in which a listener is dispatched relative to the other listeners
+ *  of the same event. Lower values are dispatched first, listeners with the
+ *  same priority are dispatched in the order they were registered.
+ *
+ *  Any value in between can be used by casting, ie. `event_priority(-50)`
+ */
+enum class event_priority : std::int32_t {
+  FIRST  = -200, // Filters that are expected to CANCEL early
+  HIGH   = -100,
+  NORMAL = 0,    // Default for listeners registered without a priority
+  LOW    = 100,
+  LAST   = 200,  // Observers that want the final state of the event
+};
+
 /*
  *  Event Listener: Chat send
  *
  *  Triggered when the player sends a message into the chat including
  *  normal text and commands
+ *
+ *  Filterable fields: MESSAGE
  */
 struct event_chat_send {
   static constexpr const char EVENT_ID[] = "evn_chat_send";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
   using fn_t = void(*)(event_chat_send * msg);
 
   event_action     action;
@@ -50,10 +124,15 @@ struct event_chat_send {
  *
  *  Triggered when a new entry to the chat log
  *  is added
+ *
+ *  Supports batch listeners, see `add_event_batch_listener`
+ *  Filterable fields: MESSAGE, SENDER_NAME, CONTEXT
  */
 struct event_chat_log {
   static constexpr const char EVENT_ID[]  = "evn_chat_log";
-  using fn_t = void(*)(event_chat_log * msg);
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
+  using fn_t       = void(*)(event_chat_log * msg);
+  using batch_fn_t = void(*)(event_chat_log * items, std::size_t n);
 
   event_action     action;
   const char     * message;      // The message that was sent to chat
@@ -70,6 +149,7 @@ struct event_chat_log {
  */
 struct event_plugin_load {
   static constexpr const char EVENT_ID[]  = "evn_plug_loaded";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
   using fn_t = void(*)(event_plugin_load * msg);
 
   sdk::plugin_intf * instance;
@@ -83,11 +163,28 @@ struct event_plugin_load {
  */
 struct event_plugin_unload {
   static constexpr const char EVENT_ID[]  = "evn_plug_unload";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
   using fn_t = void(*)(event_plugin_unload * msg);
 
   sdk::plugin_intf * instance;
 };
 
+/*
+ *  Event Listener: Plugin Reloaded
+ *
+ *  Triggered when a plugin was hot reloaded and its listeners
+ *  were swapped. `event_plugin_unload` and `event_plugin_load`
+ *  are not triggered for a hot reload.
+ */
+struct event_plugin_reload {
+  static constexpr const char EVENT_ID[]  = "evn_plug_reload";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
+  using fn_t = void(*)(event_plugin_reload * msg);
+
+  sdk::plugin_intf * previous; // Instance that was replaced, it is unloaded after the event
+  sdk::plugin_intf * instance; // The new instance
+};
+
 /*
  *  Event Listener: Dynamic Module Loaded
  *
@@ -96,27 +193,250 @@ struct event_plugin_unload {
  */
 struct event_module_load {
   static constexpr const char EVENT_ID[]  = "evn_mod_loaded";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
   using fn_t = void(*)(event_module_load * msg);
 
   sdk::plugin_intf * instance;
+  sdk::module_intf * module; // The module registered
 };
 
 /*
  *  Event Listener: Dynamic Module Unload
  *
  *  Triggered when a module is being unregistered
- *  successfuly
+ *  successfuly, including by `release_all`
  */
 struct event_module_unload {
   static constexpr const char EVENT_ID[]  = "evn_mod_unload";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
   using fn_t = void(*)(event_module_unload * msg);
 
   sdk::plugin_intf * instance;
+  sdk::module_intf * module; // The module being unregistered
+};
+
+/*
+ *  Event Listener: Plugin Released
+ *
+ *  Triggered once when `release_all` tears down everything
+ *  a plugin registered, after the `event_module_unload` of
+ *  each of its modules. Triggered even if no module was
+ *  released, in which case `module_count` is 0.
+ */
+struct event_plugin_release {
+  static constexpr const char EVENT_ID[]  = "evn_plug_release";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
+  using fn_t = void(*)(event_plugin_release * msg);
+
+  sdk::plugin_intf         * instance;     // The plugin that was released
+  sdk::module_intf * const * modules;      // Modules that were unregistered, do not use them past the event
+  std::size_t                module_count;
+};
+
+/*
+ *  Event Listener: Game Tick
+ *
+ *  Triggered on the game thread at the start of every
+ *  game simulation tick. The game thread's frame arena
+ *  is reset once the tick is done.
+ */
+struct event_tick {
+  static constexpr const char EVENT_ID[]  = "evn_tick";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
+  using fn_t = void(*)(event_tick * msg);
+
+  std::uint64_t tick_index; // Number of ticks since the client was loaded
+  float         delta_time; // Seconds elapsed since the previous tick
+};
+
+/*
+ *  Event Listener: Frame Render
+ *
+ *  Triggered on the render thread once per frame before
+ *  the frame is presented. The render thread's frame arena
+ *  is reset after it, other threads' arenas are not.
+ */
+struct event_render {
+  static constexpr const char EVENT_ID[]  = "evn_render";
+  static constexpr event_id   EVENT_UID   = sdk::fnv1a(EVENT_ID);
+  using fn_t = void(*)(event_render * msg);
+
+  std::uint64_t frame_index; // Number of frames since the client was loaded
+  float         delta_time;  // Seconds elapsed since the previous frame
 };
 
 // -- End of EVENTS
 // ---------------------------------------------------------------------------------------------------- 
 
+/*
+ *  What `queue_log_chat_n` does when the chat log queue is full
+ */
+enum class log_policy : std::uint32_t {
+  DROP     = 0, // The message is discarded and false is returned
+  COALESCE = 1, // Identical consecutive messages are merged into the pending one with a repeat count, otherwise DROP
+  BLOCK    = 2, // Waits until the game thread makes room. Behaves as DROP when called from the game thread
+};
+
+/*
+ *  Opaque handle to a listener registered through `attach_event_listener`
+ */
+enum class listener_handle : std::uint64_t {
+  INVALID = 0,
+};
+
+/*
+ *  Event field a filter is evaluated against, see `event_filter`
+ */
+enum class filter_field : std::uint32_t {
+  MESSAGE     = 0, // `event_chat_send::message`, `event_chat_log::message`
+  SENDER_NAME = 1, // `event_chat_log::sender_name`
+  CONTEXT     = 2, // `event_chat_log::context`
+};
+
+enum class filter_kind : std::uint32_t {
+  PREFIX = 0, // Field starts with the pattern
+  EXACT  = 1, // Field is equal to the pattern
+  REGEX  = 2, // ECMAScript regular expression searched in the field, compiled once when attached
+};
+
+/*
+ *  Declarative filter evaluated by the client before a listener is called,
+ *  see `attach_event_listener_filtered`. The pattern is copied by the client.
+ */
+struct event_filter {
+  filter_field   field;
+  filter_kind    kind;
+  const char   * pattern;
+  std::size_t    length;
+
+  static constexpr auto prefix(filter_field field, const char * pattern) -> event_filter {
+    return event_filter { .field = field, .kind = filter_kind::PREFIX, .pattern = pattern, .length = sdk::cstr_length(pattern) };
+  }
+
+  static constexpr auto exact(filter_field field, const char * pattern) -> event_filter {
+    return event_filter { .field = field, .kind = filter_kind::EXACT, .pattern = pattern, .length = sdk::cstr_length(pattern) };
+  }
+
+  static constexpr auto regex(filter_field field, const char * pattern) -> event_filter {
+    return event_filter { .field = field, .kind = filter_kind::REGEX, .pattern = pattern, .length = sdk::cstr_length(pattern) };
+  }
+};
+
+/*
+ *  A chat command routed to its callback, see `register_command`
+ *
+ *  The message is parsed once by the client. Arguments are split on whitespace,
+ *  double quotes group an argument and are not part of it. All views point into
+ *  the message and are only valid during the call.
+ */
+struct command_args {
+  mcstr_view         name;  // Command name without the prefix
+  const mcstr_view * argv;
+  std::size_t        argc;
+  mcstr_view         raw;   // Everything after the name, leading whitespace trimmed
+};
+
+using command_fn = void(*)(const command_args * args, void * ctx);
+
+/*
+ *  An entry of the client's chat history, see `visit_chat_history`
+ *  The views point into the history and are only valid during the visit.
+ */
+struct chat_entry {
+  std::uint64_t sequence;    // Increases by one with every entry added to the history, starts at 1
+  std::uint64_t timestamp;   // Milliseconds since the Unix epoch when added, never decreases along `sequence`
+  mcstr_view    message;
+  mcstr_view    sender_name;
+  mcstr_view    context;
+};
+
+/*
+ *  Selects the entries of the chat history to visit, every set criterion has to match
+ */
+struct chat_history_query {
+  std::uint64_t   after;       // Only entries with a greater `sequence`, 0 for all
+  std::uint64_t   since;       // Only entries with a `timestamp` of at least `since`, 0 for no bound
+  std::uint64_t   until;       // Only entries with a `timestamp` of at most `until`, 0 for no bound so 0 itself can't be a bound
+  const char    * sender;      // Exact sender name, nullptr for any
+  std::size_t     sender_len;
+  const char    * text;        // Substring of the message, nullptr for any
+  std::size_t     text_len;
+  std::size_t     limit;       // Maximum number of entries to visit, 0 for no limit
+  bool            newest_first;
+};
+
+using chat_visit_fn = bool(*)(void * ctx, const chat_entry * entry);
+
+/*
+ *  Dispatch statistics of a single event listener, see `enumerate_listener_profiles`
+ */
+struct listener_profile {
+  event_id           event;    // `EVENT_UID` of the event the listener is registered to
+  void             * listener; // The registered function pointer
+  sdk::plugin_intf * owner;    // Plugin whose image contains `listener`, nullptr if it could not be resolved
+  std::uint64_t      calls;    // Number of times the listener was dispatched
+  std::uint64_t      total_ns; // Total time spent in the listener in nanoseconds
+  std::uint64_t      max_ns;   // Longest single call in nanoseconds
+};
+
+/*
+ *  Immutable list of the plugins or modules loaded on the client
+ *  obtained through `acquire_plugins` and `acquire_modules`.
+ *
+ *  Snapshots are reference counted and owned by the client, the client
+ *  hands out the same snapshot until a plugin or module is loaded or
+ *  unloaded so acquiring one does not allocate. Release it with the
+ *  matching `release_*` call or hold it through a `snapshot_ref`.
+ */
+template <typename T>
+struct registry_snapshot {
+  std::uint64_t generation; // Value of `registry_generation` at the time the snapshot was taken
+  std::size_t   count;
+  T * const   * items;
+};
+
+using plugin_snapshot = registry_snapshot<plugin_intf>;
+using module_snapshot = registry_snapshot<module_intf>;
+
+namespace detail {
+
+// Member function pointer with its qualifiers stripped, `cls` and `sig` are void for anything else
+template <typename F>
+struct member_fn {
+  using cls = void;
+  using sig = void;
+};
+
+template <typename C, typename R, typename... A>
+struct member_fn<R (C::*)(A...)> {
+  using cls = C;
+  using sig = R(A...);
+};
+
+template <typename C, typename R, typename... A>
+struct member_fn<R (C::*)(A...) const> : member_fn<R (C::*)(A...)> {};
+
+template <typename C, typename R, typename... A>
+struct member_fn<R (C::*)(A...) noexcept> : member_fn<R (C::*)(A...)> {};
+
+template <typename C, typename R, typename... A>
+struct member_fn<R (C::*)(A...) const noexcept> : member_fn<R (C::*)(A...)> {};
+
+// Event type of a member function listener's signature, unsupported shapes are reported by `attach_event_listener`
+template <typename Sig>
+struct member_listener {
+  static constexpr bool VALID = false;
+  using event_type = void;
+};
+
+template <typename T>
+struct member_listener<void(T *)> {
+  static constexpr bool VALID = true;
+  using event_type = T;
+};
+
+}
+
 /*
  *  Interface to the Client's API
  *  Allows you to interact with the internal client.
@@ -146,6 +466,8 @@ public:
    *  To get the number of plugins loaded you can pass a nullptr
    *  to the `out` parameter. You can use this to determine what the
    *  size of your `out` array should be.
+   *
+   *  NOTE: The count can change in between calls, prefer `acquire_plugins`
    */
   virtual auto enumerate_plugins(plugin_intf * out, std::size_t * count) -> bool = 0;
 
@@ -155,22 +477,31 @@ public:
    *  To get the number of modules loaded you can pass a nullptr
    *  to the `out` parameter. You can use this to determine what the
    *  size of your `out` array should be.
+   *
+   *  NOTE: The count can change in between calls, prefer `acquire_modules`
    */
   virtual auto enumerate_modules(module_intf * out, std::size_t * count) -> bool = 0;
 
   /*
    *  Register a function listener for a specified event
+   *  Listeners registered without a priority use `event_priority::NORMAL`
    */
   virtual auto add_event_listener(const char * ename, void * fnp) -> bool = 0;
 
   /*
    *  Unregisters a function listener for a specified event
+   *  See `add_event_listener_async` on removing async listeners while they run.
    */
   virtual auto remove_event_listener(void * fnp) -> bool = 0;
 
   /*
    *  Logs a text into the ingame chat.
    *  NOTE: Only logs text, not send! This is client sided.
+   *
+   *  Messages are pushed into a bounded multi producer lock free ring buffer
+   *  of `log_queue_capacity` entries that the game thread drains every frame,
+   *  this can be called from any thread. Same as `queue_log_chat_n` with
+   *  `log_policy::DROP`, returns false if the message was dropped.
    */
   virtual auto queue_log_chat(const char * text) -> bool = 0;
 
@@ -184,6 +515,364 @@ public:
    */
   virtual auto set_mcstr(managed_string * ms, const char * str) -> managed_string * = 0;
 
+  /*
+   *  Register a function listener for an event using its `EVENT_UID`
+   *
+   *  Same as the `EVENT_ID` variant without the string lookup, the client
+   *  resolves the event directly from the integer id.
+   */
+  virtual auto add_event_listener_uid(event_id eid, void * fnp) -> bool = 0;
+
+  /*
+   *  Register a function listener for an event with a dispatch priority
+   *
+   *  The client keeps the listeners of every event in a contiguous array
+   *  sorted by priority. The array is only rebuilt when a listener is added
+   *  or removed so dispatch is a linear walk with no further lookups.
+   */
+  virtual auto add_event_listener_prio(event_id eid, void * fnp, event_priority priority) -> bool = 0;
+
+  /*
+   *  Register a batch listener for an event that provides a `batch_fn_t`
+   *
+   *  Instead of being called once per event the listener is called once per
+   *  frame with every entry that was dispatched during that frame, after the
+   *  normal listeners have run. Entries that were cancelled are not included
+   *  and the `action` field of the items is ignored.
+   *
+   *  `items` is only valid for the duration of the call.
+   *  Batch listeners are removed using `remove_event_listener`.
+   */
+  virtual auto add_event_batch_listener(event_id eid, void * fnp) -> bool = 0;
+
+  /*
+   *  Obtain a view of a `managed_string`'s buffer and length
+   *
+   *  No copy is made, the view points directly into the game's string.
+   *  LIFETIME: The view is valid until the `managed_string` is modified
+   *  or destroyed. For strings provided by an event (ie. `event_chat_send::message`)
+   *  that is at the latest when your listener returns.
+   */
+  virtual auto get_mcstr_view(managed_string * ms) -> mcstr_view = 0;
+
+  /*
+   *  Set the value of a `managed_string` from a buffer of `len` characters
+   *  `str` does not need to be null terminated.
+   */
+  virtual auto set_mcstr_n(managed_string * ms, const char * str, std::size_t len) -> managed_string * = 0;
+
+  /*
+   *  Reserve capacity in a `managed_string` for at least `capacity` characters
+   *  so following edits do not have to reallocate.
+   */
+  virtual auto reserve_mcstr(managed_string * ms, std::size_t capacity) -> managed_string * = 0;
+
+  /*
+   *  Append `len` characters to the end of a `managed_string`
+   *  Works on the game's buffer and reuses its existing capacity.
+   */
+  virtual auto append_mcstr(managed_string * ms, const char * str, std::size_t len) -> managed_string * = 0;
+
+  /*
+   *  Replace `count` characters starting at `pos` with `len` characters from `str`
+   *
+   *  `count` is clamped to the end of the string. Inserting is done with a `count`
+   *  of 0. The edit is done in place and only reallocates when the resulting size
+   *  exceeds the string's capacity. Returns nullptr if `pos` is out of range.
+   */
+  virtual auto replace_mcstr(managed_string * ms, std::size_t pos, std::size_t count, const char * str, std::size_t len) -> managed_string * = 0;
+
+  /*
+   *  Counter that is incremented every time a plugin or module is loaded or
+   *  unloaded. Compare it against a snapshot's `generation` to know when a
+   *  cached snapshot is out of date.
+   */
+  virtual auto registry_generation() -> std::uint64_t = 0;
+
+  /*
+   *  Acquire a reference to a snapshot of the loaded plugins
+   *  The snapshot never changes and stays valid until it is released.
+   */
+  virtual auto acquire_plugins() -> const plugin_snapshot * = 0;
+
+  /*
+   *  Releases a snapshot obtained from `acquire_plugins`
+   */
+  virtual auto release_plugins(const plugin_snapshot * snapshot) -> void = 0;
+
+  /*
+   *  Acquire a reference to a snapshot of the registered modules
+   *  The snapshot never changes and stays valid until it is released.
+   */
+  virtual auto acquire_modules() -> const module_snapshot * = 0;
+
+  /*
+   *  Releases a snapshot obtained from `acquire_modules`
+   */
+  virtual auto release_modules(const module_snapshot * snapshot) -> void = 0;
+
+  /*
+   *  Intern a query ID string into a token for `sdk_intf::query_token`
+   *
+   *  The same string always yields the same token for the lifetime of the
+   *  client, no matter which plugin interned it. Tokens are small and assigned
+   *  sequentially and are never `query_id::INVALID` unless `id` is a nullptr.
+   *  Intern once (ie. on load) and keep the token.
+   */
+  virtual auto intern_query_id(const char * id) -> query_id = 0;
+
+  /*
+   *  Logs `len` characters of `text` into the ingame chat, see `queue_log_chat`
+   *
+   *  `text` does not need to be null terminated and is copied into the queue.
+   *  `policy` decides what happens when the queue is full. Returns false if the
+   *  message was dropped.
+   */
+  virtual auto queue_log_chat_n(const char * text, std::size_t len, log_policy policy) -> bool = 0;
+
+  /*
+   *  Number of messages the chat log queue can hold before `log_policy` applies
+   */
+  virtual auto log_queue_capacity() -> std::size_t = 0;
+
+  /*
+   *  Logs multiple lines into the ingame chat at once, see `queue_log_chat`
+   *
+   *  The lines are pushed as a single entry so they are either all queued or all
+   *  dropped, never interleaved with messages from other threads, and the chat
+   *  UI is only laid out once for the whole batch. COALESCE behaves as DROP.
+   */
+  virtual auto queue_log_chat_batch(const char * const * lines, std::size_t n, log_policy policy) -> bool = 0;
+
+  /*
+   *  Enable or disable listener profiling, disabled by default
+   *
+   *  While disabled the client dispatches through its regular path and no
+   *  timing is done at all. Previous results are kept when disabling.
+   *  Returns the previous state. Can also be toggled with the `.prof` command.
+   */
+  virtual auto set_listener_profiling(bool enabled) -> bool = 0;
+
+  /*
+   *  Enumerate the profiling results of every listener that was
+   *  dispatched while profiling was enabled.
+   *
+   *  To get the number of entries you can pass a nullptr
+   *  to the `out` parameter. You can use this to determine what the
+   *  size of your `out` array should be.
+   */
+  virtual auto enumerate_listener_profiles(listener_profile * out, std::size_t * count) -> bool = 0;
+
+  /*
+   *  Clears the results of the listener profiler
+   */
+  virtual auto reset_listener_profiles() -> void = 0;
+
+  /*
+   *  Register a listener that is called on one of the client's worker threads
+   *
+   *  Meant for observers that do not affect the outcome of an event (ie. loggers).
+   *  The client copies the event including the strings it points to into an owned
+   *  buffer and the listener is called with that copy once the event was dispatched,
+   *  it never delays the thread that raised the event.
+   *
+   *  - The `action` field is ignored and changes to `managed_string`s are discarded
+   *  - Events are delivered to a listener in the order they were raised, one at a time
+   *  - The copy is only valid for the duration of the call
+   *  - `remove_event_listener` waits for an in-flight call of the listener to return,
+   *    except when called from inside that call where the listener is only marked
+   *    removed and no further calls are made
+   *  - Never wait from inside the call on something that removes the listener, ie.
+   *    `wait_idle` on a task calling `remove_event_listener`, that deadlocks
+   */
+  virtual auto add_event_listener_async(event_id eid, void * fnp) -> bool = 0;
+
+  /*
+   *  Obtain the client's shared task scheduler
+   *  The interface is owned by the client and is valid for as long as the client is.
+   */
+  virtual auto get_scheduler() -> scheduler_intf * = 0;
+
+  /*
+   *  Obtain the client's allocator
+   *  The interface is owned by the client and is valid for as long as the client is.
+   */
+  virtual auto get_allocator() -> allocator_intf * = 0;
+
+  /*
+   *  Hot reload a plugin from `path`, can also be done with the `.replug` command
+   *
+   *  The client never loads a plugin's DLL in place, `.plug` and `reload_plugin`
+   *  copy it to a unique shadow path and load the copy. The original file is not
+   *  locked so it can be rebuilt and reloaded from the same path, and every reload
+   *  is a new module whose entrypoint runs.
+   *
+   *  The new DLL is loaded while `instance` is still running. Listeners it
+   *  registers during its initialization are staged and not dispatched yet.
+   *  Then, on the game thread in between two ticks, the client parks `instance`:
+   *  its async listeners and scheduler tasks in flight are waited for, its
+   *  continuations are run and the client stops calling into it. While it is
+   *  parked the new instance is queried with `hot_reload_info::QUERY_ID` to move
+   *  the state over. The client then swaps the staged listeners with the previous
+   *  instance's in a single rebuild of the dispatch tables, triggers
+   *  `event_plugin_reload` and unloads the previous instance along with whatever
+   *  it still has registered.
+   *
+   *  Returns false if the new DLL could not be loaded, `instance` is left running.
+   */
+  virtual auto reload_plugin(plugin_intf * instance, const char * path) -> bool = 0;
+
+  /*
+   *  Register a function listener and obtain a handle to it
+   *
+   *  The handle records the listener's event and its entry in the dispatch table
+   *  so `detach_event_listener` does not have to search for it. The same function
+   *  can be attached more than once and to different events, each gets its own handle.
+   *  A listener attached from inside a dispatch of the same event is first called
+   *  by the next dispatch. Returns `listener_handle::INVALID` on failure.
+   */
+  virtual auto attach_event_listener(event_id eid, void * fnp, event_priority priority) -> listener_handle = 0;
+
+  /*
+   *  Unregisters a listener obtained from `attach_event_listener` in constant time
+   *
+   *  The listener is not dispatched anymore once this returns, its entry is
+   *  compacted out of the dispatch table at the end of the frame. Stale
+   *  handles are detected and return false.
+   */
+  virtual auto detach_event_listener(listener_handle handle) -> bool = 0;
+
+  /*
+   *  Unregisters everything owned by `instance` in a single pass
+   *
+   *  Covers the modules registered with `instance` as their parent, every
+   *  listener whose function lies in the plugin's image, its commands, its
+   *  channels and subscriptions, its pending scheduler tasks, which are waited
+   *  for, their game thread continuations, which are dropped without running
+   *  even when called on the game thread, and its pending storage writes, which
+   *  are flushed. The dispatch
+   *  tables are rebuilt once. An `event_module_unload` is triggered for each
+   *  released module as with `unregister_module`, followed by a single
+   *  `event_plugin_release` for the whole teardown. Handles to released
+   *  listeners become stale.
+   *
+   *  The client calls this on its own after `event_plugin_unload`.
+   */
+  virtual auto release_all(plugin_intf * instance) -> bool = 0;
+
+  /*
+   *  Attach a listener that receives a context pointer along with the event
+   *
+   *  `fnp` is called as `void(*)(T * event, void * ctx)` with the `ctx` given here,
+   *  use it to reach your plugin's state without going through globals. See the
+   *  member function helper below. Otherwise the same as `attach_event_listener`.
+   */
+  virtual auto attach_event_listener_ctx(event_id eid, void * fnp, void * ctx, event_priority priority) -> listener_handle = 0;
+
+  /*
+   *  Attach a context listener that is only called for events matching every filter
+   *
+   *  Filters are evaluated by the client before any call is made. The prefixes of all
+   *  the listeners of an event are merged into a single trie so each message is only
+   *  scanned once no matter how many filtered listeners there are. Fails with
+   *  `listener_handle::INVALID` if a field is not available on the event or a regex
+   *  does not compile. `fnp` is called the same way as with `attach_event_listener_ctx`.
+   */
+  virtual auto attach_event_listener_filtered(event_id eid, void * fnp, void * ctx, event_priority priority, const event_filter * filters, std::size_t count) -> listener_handle = 0;
+
+  /*
+   *  Register a chat command owned by `owner`, invoked as the command prefix followed by `name`
+   *
+   *  The commands of every plugin share a single prefix trie, each outgoing message
+   *  is parsed once and routed to the matching callback with its arguments split.
+   *  Messages are dispatched to `event_chat_send` listeners first as usual, so
+   *  filters and loggers keep seeing commands, and only routed if no listener
+   *  cancelled them. A routed message is consumed and not sent. Fails if the name
+   *  is empty, contains whitespace or is already taken, including by the client's
+   *  own commands such as `plug`.
+   */
+  virtual auto register_command(plugin_intf * owner, const char * name, command_fn fn, void * ctx) -> bool = 0;
+
+  /*
+   *  Unregister a command of `owner`, commands are also released by `release_all`
+   */
+  virtual auto unregister_command(plugin_intf * owner, const char * name) -> bool = 0;
+
+  /*
+   *  Obtain the client's persistent key/value store
+   *  The interface is owned by the client and is valid for as long as the client is.
+   */
+  virtual auto get_storage() -> storage_intf * = 0;
+
+  /*
+   *  Obtain the client's publish/subscribe channels
+   *  The interface is owned by the client and is valid for as long as the client is.
+   */
+  virtual auto get_channels() -> channel_intf * = 0;
+
+  /*
+   *  Visit the entries of the client's chat history matching `query` in order of
+   *  `sequence`, or in reverse with `newest_first`, until `fn` returns false.
+   *  Returns the number of entries visited.
+   *
+   *  The client keeps a single bounded history, use it instead of storing the log
+   *  in every plugin. An entry is added for every `event_chat_log` no listener
+   *  cancelled, with its strings as they were after dispatch, and the oldest entry
+   *  is dropped once `chat_history_capacity` is reached. To follow the history pass
+   *  the last `sequence` seen as `after`.
+   *
+   *  Can be called from any thread, entries added during a visit may not be visited.
+   *  The views given to `fn` are only valid during its call.
+   *
+   *  The history is indexed so that a visit does not scan it. `after`, `since` and
+   *  `until` are located by binary search and `sender` walks an index of the sender's
+   *  entries, a query using any of them costs O(log capacity) plus the entries they
+   *  select. `text` is only compared against the entries selected by the other
+   *  criteria, on its own it compares against the whole history.
+   */
+  virtual auto visit_chat_history(const chat_history_query * query, chat_visit_fn fn, void * ctx) -> std::size_t = 0;
+
+  /*
+   *  Maximum number of entries kept in the chat history, the oldest are dropped first
+   */
+  virtual auto chat_history_capacity() -> std::size_t = 0;
+
+  /*
+   *  Enable or disable the trace recorder, disabled by default
+   *
+   *  While enabled the client records every event dispatch, listener start and end,
+   *  `query` call it makes, `queue_log_chat` push, plugin load and unload and the
+   *  scopes given to `trace_begin` as compact timestamped binary records. Each
+   *  thread writes to its own lock free buffer so recording never takes a lock,
+   *  the oldest records of a thread are overwritten once its buffer is full.
+   *  Nothing is recorded while disabled. Returns the previous state.
+   */
+  virtual auto set_tracing(bool enabled) -> bool = 0;
+
+  /*
+   *  Write the records of every thread's buffer to `path` in the Chrome trace event
+   *  format, which opens in Perfetto and chrome://tracing. Recording is not
+   *  interrupted. Scopes whose begin is not in the buffers anymore are left out.
+   */
+  virtual auto export_trace(const char * path) -> bool = 0;
+
+  /*
+   *  Begin and end a scope recorded in the trace of the calling thread, see `scoped_trace`
+   *
+   *  Only the pointer to `name` is recorded, it must be a string literal or outlive
+   *  the next `export_trace`. Scopes must be ended in reverse order on the thread
+   *  that began them. Both return right away while the recorder is disabled but
+   *  still cost a virtual call each, check `tracing_flag` first on hot paths.
+   */
+  virtual auto trace_begin(const char * name) -> void = 0;
+  virtual auto trace_end() -> void = 0;
+
+  /*
+   *  Flag the client sets while the recorder is enabled, valid for as long as the client is
+   *  Obtain it once and load it with `std::memory_order_relaxed`, nullptr if tracing is not supported.
+   */
+  virtual auto tracing_flag() -> const std::atomic<bool> * = 0;
+
   // -------------------------------------------------------------------------------------------
   // -- Helpers
 
@@ -195,20 +884,385 @@ public:
   template <typename T>
   auto add_event_listener(void(*fn)(T *)) -> bool {
     static_assert(requires { T::EVENT_ID;                      }, "Event type parameter T must provide an EVENT_ID.");
+    static_assert(requires { T::EVENT_UID;                     }, "Event type parameter T must provide an EVENT_UID.");
+    static_assert(requires { typename T::fn_t;                 }, "Event type parameter T must provide an fn_t for a callback type definition.");
+    static_assert(std::is_same_v<typename T::fn_t, decltype(fn)>, "Event listener callback did not match the expected function signature.");
+    return this->add_event_listener_uid(T::EVENT_UID, reinterpret_cast<void *>(fn));
+  }
+
+  /*
+   *  Same as above but with a dispatch priority
+   *  EXAMPLE:
+   *    client->add_event_listener(+[](event_chat_send * e) { ... }, event_priority::FIRST);
+   */
+  template <typename T>
+  auto add_event_listener(void(*fn)(T *), event_priority priority) -> bool {
+    static_assert(requires { T::EVENT_UID;                     }, "Event type parameter T must provide an EVENT_UID.");
+    static_assert(requires { typename T::fn_t;                 }, "Event type parameter T must provide an fn_t for a callback type definition.");
+    static_assert(std::is_same_v<typename T::fn_t, decltype(fn)>, "Event listener callback did not match the expected function signature.");
+    return this->add_event_listener_prio(T::EVENT_UID, reinterpret_cast<void *>(fn), priority);
+  }
+
+  /*
+   *  Helper function to register batch listeners with type checks for callbacks.
+   *  EXAMPLE:
+   *    client->add_event_batch_listener(+[](event_chat_log * items, std::size_t n) { ... });
+   */
+  template <typename T>
+  auto add_event_batch_listener(void(*fn)(T *, std::size_t)) -> bool {
+    static_assert(requires { T::EVENT_UID;                           }, "Event type parameter T must provide an EVENT_UID.");
+    static_assert(requires { typename T::batch_fn_t;                 }, "Event type parameter T does not support batch listeners.");
+    static_assert(std::is_same_v<typename T::batch_fn_t, decltype(fn)>, "Batch listener callback did not match the expected function signature.");
+    return this->add_event_batch_listener(T::EVENT_UID, reinterpret_cast<void *>(fn));
+  }
+
+  /*
+   *  Helper function to register async listeners with type checks for callbacks.
+   *  EXAMPLE:
+   *    client->add_event_listener_async(+[](event_chat_log * e) { archive(e->message); });
+   */
+  template <typename T>
+  auto add_event_listener_async(void(*fn)(T *)) -> bool {
+    static_assert(requires { T::EVENT_UID;                     }, "Event type parameter T must provide an EVENT_UID.");
+    static_assert(requires { typename T::fn_t;                 }, "Event type parameter T must provide an fn_t for a callback type definition.");
+    static_assert(std::is_same_v<typename T::fn_t, decltype(fn)>, "Event listener callback did not match the expected function signature.");
+    return this->add_event_listener_async(T::EVENT_UID, reinterpret_cast<void *>(fn));
+  }
+
+  /*
+   *  Helper function to attach event listeners with type checks for callbacks.
+   *  See `scoped_listener` to have it detached automatically.
+   *  EXAMPLE:
+   *    sdk::scoped_listener l(client, client->attach_event_listener(+[](event_chat_send * e) { ... }));
+   */
+  template <typename T>
+  auto attach_event_listener(void(*fn)(T *), event_priority priority = event_priority::NORMAL) -> listener_handle {
+    static_assert(requires { T::EVENT_UID;                     }, "Event type parameter T must provide an EVENT_UID.");
+    static_assert(requires { typename T::fn_t;                 }, "Event type parameter T must provide an fn_t for a callback type definition.");
+    static_assert(std::is_same_v<typename T::fn_t, decltype(fn)>, "Event listener callback did not match the expected function signature.");
+    return this->attach_event_listener(T::EVENT_UID, reinterpret_cast<void *>(fn), priority);
+  }
+
+  /*
+   *  Same as above with a context pointer, see `attach_event_listener_ctx`
+   *  EXAMPLE:
+   *    client->attach_event_listener(+[](event_chat_send * e, void * ctx) { ... }, this);
+   */
+  template <typename T>
+  auto attach_event_listener(void(*fn)(T *, void *), void * ctx, event_priority priority = event_priority::NORMAL) -> listener_handle {
+    static_assert(requires { T::EVENT_UID;     }, "Event type parameter T must provide an EVENT_UID.");
+    static_assert(requires { typename T::fn_t; }, "Event type parameter T must provide an fn_t for a callback type definition.");
+    return this->attach_event_listener_ctx(T::EVENT_UID, reinterpret_cast<void *>(fn), ctx, priority);
+  }
+
+  /*
+   *  Attach a member function of `instance` as a listener, the event type is deduced
+   *  from the member function's parameter. The function can be const or noexcept.
+   *  EXAMPLE:
+   *    class myplugin : public sdk::plugin_intf {
+   *      auto on_chat(sdk::event_chat_send * e) -> void;
+   *      ...
+   *      on_chat_listener = sdk::scoped_listener(client, client->attach_event_listener<&myplugin::on_chat>(this));
+   *    };
+   */
+  template <auto method, typename C>
+  auto attach_event_listener(C * instance, event_priority priority = event_priority::NORMAL) -> listener_handle {
+    using fn     = detail::member_fn<decltype(method)>;
+    using traits = detail::member_listener<typename fn::sig>;
+    using T      = typename traits::event_type;
+    static_assert(traits::VALID,                                "Member function listeners must be shaped as auto (T * e) -> void, optionally const or noexcept.");
+    static_assert(std::is_base_of_v<typename fn::cls, C>,       "Member function listener does not belong to the instance's class.");
+    static_assert(!traits::VALID || requires { T::EVENT_UID; }, "Event type parameter T must provide an EVENT_UID.");
+
+    if constexpr (traits::VALID && std::is_base_of_v<typename fn::cls, C>) {
+      void(*thunk)(T *, void *) = +[](T * e, void * ctx) {
+        (static_cast<C *>(ctx)->*method)(e);
+      };
+      return this->attach_event_listener_ctx(T::EVENT_UID, reinterpret_cast<void *>(thunk), instance, priority);
+    } else {
+      return listener_handle::INVALID;
+    }
+  }
+
+  /*
+   *  Attach a filtered listener, see `attach_event_listener_filtered`
+   *  EXAMPLE:
+   *    const sdk::event_filter filters[] = { sdk::event_filter::prefix(sdk::filter_field::MESSAGE, ".stats") };
+   *    client->attach_event_listener(+[](event_chat_send * e) { ... }, filters);
+   */
+  template <typename T, std::size_t N>
+  auto attach_event_listener(void(*fn)(T *), const event_filter (&filters)[N], event_priority priority = event_priority::NORMAL) -> listener_handle {
+    static_assert(requires { T::EVENT_UID;                     }, "Event type parameter T must provide an EVENT_UID.");
     static_assert(requires { typename T::fn_t;                 }, "Event type parameter T must provide an fn_t for a callback type definition.");
     static_assert(std::is_same_v<typename T::fn_t, decltype(fn)>, "Event listener callback did not match the expected function signature.");
-    return this->add_event_listener(T::EVENT_ID, fn);
+
+    // The plain callback is carried as the context of a thunk
+    void(*thunk)(T *, void *) = +[](T * e, void * ctx) {
+      reinterpret_cast<typename T::fn_t>(ctx)(e);
+    };
+    return this->attach_event_listener_filtered(T::EVENT_UID, reinterpret_cast<void *>(thunk), reinterpret_cast<void *>(fn), priority, filters, N);
+  }
+
+  template <typename T, std::size_t N>
+  auto attach_event_listener(void(*fn)(T *, void *), void * ctx, const event_filter (&filters)[N], event_priority priority = event_priority::NORMAL) -> listener_handle {
+    static_assert(requires { T::EVENT_UID; }, "Event type parameter T must provide an EVENT_UID.");
+    return this->attach_event_listener_filtered(T::EVENT_UID, reinterpret_cast<void *>(fn), ctx, priority, filters, N);
+  }
+
+  /*
+   *  Register a command without a context
+   *  EXAMPLE:
+   *    client->register_command(mypluginst, "stats", +[](const sdk::command_args * args) { ... });
+   */
+  auto register_command(plugin_intf * owner, const char * name, void(*fn)(const command_args *)) -> bool {
+    // The plain callback is carried as the context of a thunk
+    command_fn thunk = +[](const command_args * args, void * ctx) {
+      reinterpret_cast<void(*)(const command_args *)>(ctx)(args);
+    };
+    return this->register_command(owner, name, thunk, reinterpret_cast<void *>(fn));
+  }
+
+  /*
+   *  Register a member function of `instance` as a command
+   *  EXAMPLE:
+   *    client->register_command<&myplugin::on_stats>(mypluginst, "stats", mypluginst);
+   */
+  template <auto method, typename C>
+  auto register_command(plugin_intf * owner, const char * name, C * instance) -> bool {
+    return this->register_command(owner, name, +[](const command_args * args, void * ctx) { (static_cast<C *>(ctx)->*method)(args); }, instance);
+  }
+
+  /*
+   *  Visit the chat history with a callable
+   *  EXAMPLE:
+   *    sdk::chat_history_query q = { .sender = "steve", .sender_len = 5, .limit = 10, .newest_first = true };
+   *    client->visit_chat_history(q, [&](const sdk::chat_entry & e) { ...; return true; });
+   */
+  template <typename F>
+  auto visit_chat_history(const chat_history_query & query, F && fn) -> std::size_t {
+    return this->visit_chat_history(&query, +[](void * ctx, const chat_entry * entry) -> bool {
+      return (*static_cast<std::remove_reference_t<F> *>(ctx))(*entry);
+    }, const_cast<void *>(static_cast<const void *>(std::addressof(fn))));
+  }
+
+  /*
+   *  Set the value of a `managed_string` with a string of known length
+   */
+  auto set_mcstr(managed_string * ms, const char * str, std::size_t len) -> managed_string * {
+    return this->set_mcstr_n(ms, str, len);
+  }
+
+  auto set_mcstr(managed_string * ms, mcstr_view str) -> managed_string * {
+    return this->set_mcstr_n(ms, str.data, str.size);
+  }
+
+  /*
+   *  Insert `len` characters at the start of a `managed_string`
+   *  EXAMPLE:
+   *    client->prepend_mcstr(e->display_text, "[Guild] ", 8);
+   */
+  auto prepend_mcstr(managed_string * ms, const char * str, std::size_t len) -> managed_string * {
+    return this->replace_mcstr(ms, 0, 0, str, len);
+  }
+
+  auto queue_log_chat_n(const char * text, std::size_t len) -> bool {
+    return this->queue_log_chat_n(text, len, log_policy::DROP);
+  }
+
+  /*
+   *  EXAMPLE:
+   *    const char * lines[] = { "line 1", "line 2" };
+   *    client->queue_log_chat_batch(lines, 2);
+   */
+  auto queue_log_chat_batch(const char * const * lines, std::size_t n) -> bool {
+    return this->queue_log_chat_batch(lines, n, log_policy::DROP);
   }
 
   // -- End of Helpers
   // -------------------------------------------------------------------------------------------
 };
 
+/*
+ *  Move only owner of a `listener_handle`, detaches the listener once destroyed.
+ *  EXAMPLE:
+ *    sdk::scoped_listener on_chat;
+ *    ...
+ *    on_chat = sdk::scoped_listener(client, client->attach_event_listener(+[](sdk::event_chat_send * e) { ... }));
+ *    ...
+ *    on_chat.reset(); // Or let it go out of scope
+ */
+class scoped_listener {
+public:
+  scoped_listener() = default;
+  scoped_listener(client_intf * client, listener_handle handle) : client(client), handle(handle) {}
+  ~scoped_listener() { this->reset(); }
+
+  scoped_listener(const scoped_listener &) = delete;
+  auto operator=(const scoped_listener &) -> scoped_listener & = delete;
+
+  scoped_listener(scoped_listener && other) noexcept : client(other.client), handle(other.release()) {}
+
+  auto operator=(scoped_listener && other) noexcept -> scoped_listener & {
+    if (this != &other) {
+      this->reset();
+      this->client = other.client;
+      this->handle = other.release();
+    }
+    return *this;
+  }
+
+  /*
+   *  Detaches the listener if one is held
+   */
+  auto reset() -> void {
+    if (this->handle != listener_handle::INVALID)
+      this->client->detach_event_listener(this->handle);
+    this->handle = listener_handle::INVALID;
+  }
+
+  /*
+   *  Gives up ownership of the handle without detaching it
+   */
+  auto release() -> listener_handle {
+    listener_handle h = this->handle;
+    this->handle = listener_handle::INVALID;
+    return h;
+  }
+
+  auto get() const -> listener_handle { return this->handle; }
+  explicit operator bool() const { return this->handle != listener_handle::INVALID; }
+
+private:
+  client_intf     * client = nullptr;
+  listener_handle   handle = listener_handle::INVALID;
+};
+
+/*
+ *  Records the lifetime of the scope in the trace, see `client_intf::trace_begin`
+ *
+ *  Given the client's `tracing_flag` a scope costs a single relaxed load while the
+ *  recorder is disabled, without it a scope always costs two virtual calls.
+ *  EXAMPLE:
+ *    const std::atomic<bool> * tracing = client->tracing_flag(); // Once at load
+ *    ...
+ *    {
+ *      sdk::scoped_trace trace(client, tracing, "myplugin::rebuild_cache");
+ *      ...
+ *    }
+ */
+class scoped_trace {
+public:
+  scoped_trace(client_intf * client, const char * name) : client(client) { this->client->trace_begin(name); }
+
+  scoped_trace(client_intf * client, const std::atomic<bool> * enabled, const char * name)
+    : client(enabled && enabled->load(std::memory_order_relaxed) ? client : nullptr) {
+    if (this->client)
+      this->client->trace_begin(name);
+  }
+
+  ~scoped_trace() {
+    if (this->client)
+      this->client->trace_end();
+  }
+
+  scoped_trace(const scoped_trace &) = delete;
+  auto operator=(const scoped_trace &) -> scoped_trace & = delete;
+
+private:
+  client_intf * client;
+};
+
+/*
+ *  Owning reference to a `registry_snapshot`. Releases the snapshot once destroyed.
+ *  EXAMPLE:
+ *    sdk::snapshot_ref<sdk::module_intf> modules(client);
+ *    ...
+ *    modules.refresh(); // Only re-acquires when a module was (un)registered
+ *    for (sdk::module_intf * mod : modules) { ... }
+ */
+template <typename T>
+class snapshot_ref {
+  static_assert(std::is_same_v<T, plugin_intf> || std::is_same_v<T, module_intf>, "Snapshots are only provided for plugin_intf and module_intf.");
+public:
+  snapshot_ref() = default;
+  explicit snapshot_ref(client_intf * client) : client(client) { this->refresh(); }
+  ~snapshot_ref() { this->reset(); }
+
+  snapshot_ref(const snapshot_ref &) = delete;
+  auto operator=(const snapshot_ref &) -> snapshot_ref & = delete;
+
+  snapshot_ref(snapshot_ref && other) noexcept : client(other.client), snapshot(other.snapshot) {
+    other.snapshot = nullptr;
+  }
+
+  auto operator=(snapshot_ref && other) noexcept -> snapshot_ref & {
+    if (this != &other) {
+      this->reset();
+      this->client   = other.client;
+      this->snapshot = other.snapshot;
+      other.snapshot = nullptr;
+    }
+    return *this;
+  }
+
+  /*
+   *  Re-acquires the snapshot if the client's registry changed since it was taken.
+   *  Returns true if the snapshot was replaced.
+   */
+  auto refresh() -> bool {
+    if (!this->client || (this->snapshot && this->snapshot->generation == this->client->registry_generation()))
+      return false;
+
+    const registry_snapshot<T> * latest = nullptr;
+    if constexpr (std::is_same_v<T, plugin_intf>)
+      latest = this->client->acquire_plugins();
+    else
+      latest = this->client->acquire_modules();
+
+    this->reset();
+    this->snapshot = latest;
+    return true;
+  }
+
+  auto reset() -> void {
+    if (!this->snapshot)
+      return;
+
+    if constexpr (std::is_same_v<T, plugin_intf>)
+      this->client->release_plugins(this->snapshot);
+    else
+      this->client->release_modules(this->snapshot);
+    this->snapshot = nullptr;
+  }
+
+  auto get()   const -> const registry_snapshot<T> * { return this->snapshot; }
+  auto size()  const -> std::size_t { return this->snapshot ? this->snapshot->count : 0; }
+  auto begin() const -> T * const * { return this->snapshot ? this->snapshot->items : nullptr; }
+  auto end()   const -> T * const * { return this->begin() + this->size(); }
+
+private:
+  client_intf                * client   = nullptr;
+  const registry_snapshot<T> * snapshot = nullptr;
+};
+
 struct load_info {
   sdk::ver_info client_sdk_version;
   sdk::client_intf * client;
 
   sdk::plugin_intf * instance;
+
+  sdk::client_caps capabilities; // Optional services supported by the client, set by clients from 1.1 on
+
+  /*
+   *  Check if the client supports every capability in `caps`
+   *  EXAMPLE:
+   *    use_async = info->has(sdk::client_caps::SCHEDULER | sdk::client_caps::ASYNC_LISTENERS);
+   */
+  constexpr auto has(client_caps caps) const -> bool {
+    if (this->client_sdk_version.major == 1 && this->client_sdk_version.minor < 1)
+      return caps == client_caps::NONE;
+    return (this->capabilities & caps) == caps;
+  }
 };
 
 } // sdk
@@ -1 +1,429 @@
 #pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+#include "types.hpp"
+#include "client_interface.hpp"
+
+namespace sdk {
+
+/*
+ *  Table of query IDs an implementer responds to, resolved into tokens
+ *  once so `query_token` can be routed through a switch.
+ *
+ *  Tokens are small integers handed out in order by the client, `find` indexes
+ *  a dense array with the token's offset from the smallest one of the table.
+ *  Only when the tokens are spread over more than `4 * N` values, ie. some IDs
+ *  were interned long before the others, it falls back to a binary search.
+ *  EXAMPLE:
+ *    static constexpr const char * IDS[] = { "register_callback", "parse" };
+ *    sdk::query_id_table<2> ids { IDS };
+ *    ids.intern(client);
+ *
+ *    auto query_token(sdk::query_id id, void * ptr, std::uint64_t size) -> bool override {
+ *      switch (ids.find(id)) {
+ *        case 0: ... // register_callback
+ *        case 1: ... // parse
+ *      }
+ *      return false;
+ *    }
+ */
+template <std::size_t N>
+class query_id_table {
+  static constexpr std::size_t DENSE_SIZE = 4 * N;
+public:
+  constexpr query_id_table(const char * const (&ids)[N]) {
+    for (std::size_t i = 0; i < N; ++i)
+      this->names[i] = ids[i];
+  }
+
+  /*
+   *  Resolve the IDs into tokens, has to be called before `find`
+   */
+  auto intern(client_intf * client) -> void {
+    std::uint32_t low  = UINT32_MAX;
+    std::uint32_t high = 0;
+    this->count = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      this->tokens[i] = client->intern_query_id(this->names[i]);
+      if (this->tokens[i] == query_id::INVALID)
+        continue;
+
+      const std::uint32_t raw = static_cast<std::uint32_t>(this->tokens[i]);
+      low  = std::min(low, raw);
+      high = std::max(high, raw);
+      this->sorted[this->count++] = sorted_entry { .token = this->tokens[i], .index = i };
+    }
+
+    std::sort(this->sorted.begin(), this->sorted.begin() + this->count, [](const sorted_entry & lhs, const sorted_entry & rhs) { return lhs.token < rhs.token; });
+
+    this->base       = low;
+    this->dense_span = 0;
+    if (this->count && high - low < DENSE_SIZE) {
+      this->dense_span = high - low + 1;
+      this->dense.fill(N);
+      for (std::size_t i = 0; i < this->count; ++i)
+        this->dense[static_cast<std::uint32_t>(this->sorted[i].token) - low] = this->sorted[i].index;
+    }
+  }
+
+  /*
+   *  Index of the ID matching `id` or N if it's not part of the table
+   */
+  auto find(query_id id) const -> std::size_t {
+    // Tokens below `base` wrap around and fail the bound check, so does INVALID
+    const std::uint32_t offset = static_cast<std::uint32_t>(id) - this->base;
+    if (this->dense_span)
+      return offset < this->dense_span ? this->dense[offset] : N;
+
+    const auto end = this->sorted.begin() + this->count;
+    const auto it  = std::lower_bound(this->sorted.begin(), end, id, [](const sorted_entry & e, query_id t) { return e.token < t; });
+    return it != end && it->token == id ? it->index : N;
+  }
+
+  auto name(std::size_t index) const -> const char * { return this->names[index]; }
+  auto token(std::size_t index) const -> query_id { return this->tokens[index]; }
+
+private:
+  struct sorted_entry {
+    query_id    token;
+    std::size_t index;
+  };
+
+  const char *                          names[N]   = {};
+  query_id                              tokens[N]  = {};
+  std::uint32_t                         base       = 0;
+  std::uint32_t                         dense_span = 0;    // 0 when `dense` is not used
+  std::array<std::size_t, DENSE_SIZE>   dense      = {};   // Table index by token offset, N for no match
+  std::array<sorted_entry, N>           sorted     = {};   // Fallback, sorted by token
+  std::size_t                           count      = 0;
+};
+
+/*
+ *  Cached table of function pointers resolved from a module through `vtable_request`.
+ *
+ *  `T` is a struct of function pointers that provides a `NAME` and `VERSION`. The handle
+ *  has to be invalidated when its owner is unregistered, forward your `event_module_unload`
+ *  listener to `invalidate`. It is also triggered for the modules released by `release_all`,
+ *  handling `event_plugin_release` as well is optional.
+ *  EXAMPLE:
+ *    struct parser_vtable {
+ *      static constexpr const char    NAME[]  = "chat_parser";
+ *      static constexpr std::uint32_t VERSION = 1;
+ *      auto (*parse)(const char * text, std::size_t len) -> bool;
+ *    };
+ *
+ *    sdk::vtable_handle<parser_vtable> parser;
+ *    parser.resolve(module);
+ *    if (parser)
+ *      parser->parse(text, len);
+ *    ...
+ *    client->add_event_listener(+[](sdk::event_module_unload * e) { parser.invalidate(e); });
+ */
+template <typename T>
+class vtable_handle {
+  static_assert(requires { T::NAME; T::VERSION; }, "Function table type T must provide a NAME and a VERSION.");
+public:
+  /*
+   *  Resolve the table from `owner`, returns false if the owner does not provide it
+   *  or the table provided is smaller than `T`.
+   */
+  auto resolve(module_intf * owner) -> bool {
+    this->reset();
+    if (!owner)
+      return false;
+
+    vtable_request req = {
+      .name    = T::NAME,
+      .version = T::VERSION,
+      .table   = nullptr,
+      .size    = 0,
+    };
+
+    if (!owner->query(vtable_request::QUERY_ID, &req) || !req.table || req.size < sizeof(T))
+      return false;
+
+    this->owner_mod = owner;
+    this->table     = static_cast<const T *>(req.table);
+    return true;
+  }
+
+  /*
+   *  Drops the table if the module being unloaded is its owner
+   *  Returns true if the handle was invalidated.
+   */
+  auto invalidate(event_module_unload * e) -> bool {
+    if (!this->table || e->module != this->owner_mod)
+      return false;
+
+    this->reset();
+    return true;
+  }
+
+  /*
+   *  Drops the table if its owner was one of the released plugin's modules
+   */
+  auto invalidate(event_plugin_release * e) -> bool {
+    if (!this->table)
+      return false;
+
+    for (std::size_t i = 0; i < e->module_count; ++i) {
+      if (e->modules[i] == this->owner_mod) {
+        this->reset();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  auto reset() -> void {
+    this->owner_mod = nullptr;
+    this->table     = nullptr;
+  }
+
+  auto owner() const -> module_intf * { return this->owner_mod; }
+  auto get()   const -> const T * { return this->table; }
+
+  auto operator->() const -> const T * { return this->table; }
+  explicit operator bool() const { return this->table != nullptr; }
+
+private:
+  module_intf * owner_mod = nullptr;
+  const T     * table     = nullptr;
+};
+
+/*
+ *  String literal usable as a template argument, used for `query_route` IDs
+ */
+template <std::size_t N>
+struct fixed_string {
+  constexpr fixed_string(const char (&str)[N]) {
+    std::copy_n(str, N, this->value);
+  }
+
+  char value[N];
+};
+
+/*
+ *  Pairs a query ID with the member function that handles it, see `query_router`
+ *
+ *  The handler is either `auto (T::*)(void * ptr, std::uint64_t size) -> bool` or
+ *  `auto (T::*)(U * ptr) -> bool`, `U` not being void, in which case the query's
+ *  size is checked against `sizeof(U)` before the handler is called. Handlers can be const or
+ *  noexcept and `T` can be a base of the router.
+ */
+template <fixed_string id, auto handler>
+struct query_route {
+  static constexpr const char * ID      = id.value;
+  static constexpr auto         HANDLER = handler;
+};
+
+namespace detail {
+
+// Unsupported handler shapes are reported by `route_table`
+template <typename Sig>
+struct route_handler {
+  static constexpr bool VALID = false;
+
+  template <auto handler, typename Derived>
+  static auto call(Derived *, void *, std::uint64_t) -> bool { return false; }
+};
+
+template <>
+struct route_handler<auto (void *, std::uint64_t) -> bool> {
+  static constexpr bool VALID = true;
+
+  template <auto handler, typename Derived>
+  static auto call(Derived * self, void * ptr, std::uint64_t size) -> bool {
+    return (self->*handler)(ptr, size);
+  }
+};
+
+// `void *` alone is rejected, `sizeof(void)` would only be accepted as an extension
+template <typename U> requires (!std::is_void_v<U>)
+struct route_handler<auto (U *) -> bool> {
+  static constexpr bool VALID = true;
+
+  template <auto handler, typename Derived>
+  static auto call(Derived * self, void * ptr, std::uint64_t size) -> bool {
+    if (size != sizeof(U))
+      return false;
+    return (self->*handler)(static_cast<U *>(ptr));
+  }
+};
+
+template <typename Derived, typename Route>
+inline constexpr bool valid_route =
+  route_handler<typename member_fn<std::remove_const_t<decltype(Route::HANDLER)>>::sig>::VALID &&
+  std::is_base_of_v<typename member_fn<std::remove_const_t<decltype(Route::HANDLER)>>::cls, Derived>;
+
+}
+
+/*
+ *  Compile time list of `query_route`s, see `query_router`
+ */
+template <typename... Routes>
+struct query_routes {};
+
+namespace detail {
+
+template <typename Derived, typename Routes>
+struct route_table;
+
+template <typename Derived, typename... Routes>
+struct route_table<Derived, query_routes<Routes...>> {
+  static_assert(sizeof...(Routes) > 0, "query_routes requires at least one route.");
+  static_assert(sizeof...(Routes) < UINT16_MAX, "query_routes has too many routes.");
+  static_assert((valid_route<Derived, Routes> && ...),
+    "query_route handlers must be member functions of Derived or one of its bases shaped as "
+    "auto (void * ptr, std::uint64_t size) -> bool or auto (U * ptr) -> bool with U not void, optionally const or noexcept.");
+
+  static constexpr std::size_t N = sizeof...(Routes);
+
+  using thunk_fn = auto(*)(Derived * self, void * ptr, std::uint64_t size) -> bool;
+
+  struct entry {
+    std::size_t    length;
+    const char   * id;
+    thunk_fn       thunk;
+  };
+
+  // Orders by length first, then bytewise so IDs of the same length compare with memcmp
+  static constexpr auto compare(std::size_t lhs_len, const char * lhs, std::size_t rhs_len, const char * rhs) -> int {
+    if (lhs_len != rhs_len)
+      return lhs_len < rhs_len ? -1 : 1;
+    for (std::size_t i = 0; i < lhs_len; ++i)
+      if (lhs[i] != rhs[i])
+        return static_cast<unsigned char>(lhs[i]) < static_cast<unsigned char>(rhs[i]) ? -1 : 1;
+    return 0;
+  }
+
+  static constexpr std::array<thunk_fn, N> thunks = {
+    &route_handler<typename member_fn<std::remove_const_t<decltype(Routes::HANDLER)>>::sig>::template call<Routes::HANDLER, Derived>...
+  };
+
+  static constexpr const char * names[N] = { Routes::ID... };
+
+  static constexpr std::array<entry, N> entries = [] {
+    std::array<entry, N> table = {};
+    for (std::size_t i = 0; i < N; ++i)
+      table[i] = entry { .length = sdk::cstr_length(names[i]), .id = names[i], .thunk = thunks[i] };
+
+    std::sort(table.begin(), table.end(), [](const entry & lhs, const entry & rhs) { return compare(lhs.length, lhs.id, rhs.length, rhs.id) < 0; });
+    return table;
+  }();
+
+  static_assert(std::adjacent_find(entries.begin(), entries.end(), [](const entry & lhs, const entry & rhs) { return compare(lhs.length, lhs.id, rhs.length, rhs.id) == 0; }) == entries.end(),
+    "query_route IDs are duplicated.");
+
+  static constexpr std::size_t MAX_LENGTH = [] {
+    std::size_t longest = 0;
+    for (const entry & e : entries)
+      longest = std::max(longest, e.length);
+    return longest;
+  }();
+
+  // `entries[buckets[len]]` up to `entries[buckets[len + 1]]` are the routes of length `len`
+  static constexpr std::array<std::uint16_t, MAX_LENGTH + 2> buckets = [] {
+    std::array<std::uint16_t, MAX_LENGTH + 2> starts = {};
+    std::size_t i = 0;
+    for (std::size_t len = 0; len <= MAX_LENGTH + 1; ++len) {
+      while (i < N && entries[i].length < len)
+        ++i;
+      starts[len] = static_cast<std::uint16_t>(i);
+    }
+    return starts;
+  }();
+
+  // Tokens are the same for every instance, they are interned per client
+  static inline query_id_table<N> tokens { names };
+
+  static auto route(Derived * self, const char * id, void * ptr, std::uint64_t size) -> bool {
+    const std::size_t length = std::strlen(id);
+    if (length > MAX_LENGTH)
+      return false;
+
+    std::size_t low  = buckets[length];
+    std::size_t high = buckets[length + 1];
+    while (low < high) {
+      const std::size_t mid = (low + high) / 2;
+      const int         cmp = std::memcmp(entries[mid].id, id, length);
+      if (cmp == 0)
+        return entries[mid].thunk(self, ptr, size);
+
+      if (cmp < 0)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+
+    return false;
+  }
+
+  // `find` indexes the table's dense token array, see `query_id_table`
+  static auto route(Derived * self, query_id id, void * ptr, std::uint64_t size) -> bool {
+    const std::size_t index = tokens.find(id);
+    if (index == N)
+      return false;
+
+    return thunks[index](self, ptr, size);
+  }
+};
+
+}
+
+/*
+ *  CRTP base that implements `query` for a `plugin_intf` or `module_intf` from
+ *  the compile time list of `query_route`s given by `Derived::routes`.
+ *
+ *  String queries index the routes by the ID's length, sorted by length then bytes
+ *  at compile time, and binary search the few routes of that length with memcmp
+ *  instead of doing a strcmp per route. Token queries index the
+ *  handlers through `query_id_table` once `intern_queries` was called. Duplicate
+ *  route IDs are rejected at compile time.
+ *  The handlers have to be declared before `routes`.
+ *  EXAMPLE:
+ *    class chat_parser : public sdk::query_router<chat_parser, sdk::module_intf> {
+ *    public:
+ *      auto on_register(void * ptr, std::uint64_t size) -> bool;
+ *      auto on_parse(parse_request * req) -> bool;
+ *
+ *      using routes = sdk::query_routes<
+ *        sdk::query_route<"register_callback", &chat_parser::on_register>,
+ *        sdk::query_route<"parse",             &chat_parser::on_parse>
+ *      >;
+ *    };
+ *
+ *    parser->intern_queries(client);
+ */
+template <typename Derived, typename Base>
+class query_router : public Base {
+  static_assert(std::is_base_of_v<sdk::sdk_intf, Base>, "query_router Base must be an SDK interface.");
+public:
+  using Base::query;
+
+  /*
+   *  Resolve the route IDs into tokens to also answer `query_token`
+   */
+  auto intern_queries(client_intf * client) -> void {
+    detail::route_table<Derived, typename Derived::routes>::tokens.intern(client);
+  }
+
+  auto query(const char * id, void * ptr, std::uint64_t size) -> bool override {
+    if (!id)
+      return false;
+    return detail::route_table<Derived, typename Derived::routes>::route(static_cast<Derived *>(this), id, ptr, size);
+  }
+
+  auto query_token(query_id id, void * ptr, std::uint64_t size) -> bool override {
+    return detail::route_table<Derived, typename Derived::routes>::route(static_cast<Derived *>(this), id, ptr, size);
+  }
+};
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "types.hpp"
+#include "client_interface.hpp"
+
+#if defined(_WIN32)
+  #define MCBRE_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+  #define MCBRE_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+namespace sdk {
+
+enum class manifest_flags : std::uint32_t {
+  NONE          = 0,
+  PARALLEL_LOAD = 1 << 0, // DllMain has no side effects, the DLL can be loaded alongside other plugins
+  LAZY_INIT     = 1 << 1, // Defer `init` until one of the manifest's `events` is first dispatched
+};
+
+constexpr auto operator|(manifest_flags lhs, manifest_flags rhs) -> manifest_flags {
+  return static_cast<manifest_flags>(static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs));
+}
+
+/*
+ *  Returns the flags set in both, the same as `client_caps`. Compare the result
+ *  against `manifest_flags::NONE` or use `has_flags` for a test.
+ */
+constexpr auto operator&(manifest_flags lhs, manifest_flags rhs) -> manifest_flags {
+  return static_cast<manifest_flags>(static_cast<std::uint32_t>(lhs) & static_cast<std::uint32_t>(rhs));
+}
+
+/*
+ *  Check if every flag of `test` is set in `flags`
+ */
+constexpr auto has_flags(manifest_flags flags, manifest_flags test) -> bool {
+  return (flags & test) == test;
+}
+
+/*
+ *  Plugin initialization entrypoint, the `load_info` handshake without DllMain.
+ *  Exported from a plugin through `MCBRE_PLUGIN_INIT` or given by its manifest.
+ *
+ *  The client calls it after LoadLibrary has returned so it does not run under
+ *  the loader lock, spawning threads, allocating and heavy setup is safe here.
+ *  The initialization of separate plugins may run concurrently.
+ *  Set `info->instance` the same way DllMain would, return false to abort loading.
+ *
+ *  The client looks for an entrypoint in this order and only uses the first found:
+ *    1. The manifest's `init`
+ *    2. The exported `mcbre_plugin_init`
+ *    3. The `load_info` passed through DllMain's lpReserved (legacy)
+ *  To support clients that predate the exported entrypoint keep the DllMain
+ *  handshake as well, lpReserved is a nullptr when the entrypoint is used.
+ *  This is decided when building the plugin, there is no `client_caps` bit for
+ *  it as the capabilities are only known once one of the entrypoints ran.
+ */
+using plugin_init_fn = auto(*)(load_info * info) -> bool;
+
+/*
+ *  Name of the exported initialization function, it has to match `plugin_init_fn`
+ */
+inline constexpr const char INIT_SYMBOL[] = "mcbre_plugin_init";
+
+/*
+ *  Plugin manifest, exported from a plugin through `MCBRE_PLUGIN_MANIFEST`
+ *
+ *  At startup the client reads the manifest of every plugin it autoloads
+ *  before initializing any of them. Plugins with `PARALLEL_LOAD` are loaded
+ *  concurrently and plugins with `LAZY_INIT` are only initialized right
+ *  before one of `events` is dispatched for the first time, listeners
+ *  registered during `init` receive that event.
+ */
+struct plugin_manifest {
+  ver_info         sdk_version; // Set to `sdk::version`
+  manifest_flags   flags;
+  plugin_init_fn   init;        // nullptr to use the exported `mcbre_plugin_init`
+  const event_id * events;      // `EVENT_UID`s that trigger a `LAZY_INIT`
+  std::size_t      event_count;
+};
+
+/*
+ *  Name of the exported manifest function, it has to match `manifest_fn`
+ */
+inline constexpr const char MANIFEST_SYMBOL[] = "mcbre_plugin_manifest";
+using manifest_fn = auto(*)() -> const plugin_manifest *;
+
+}
+
+/*
+ *  Exports a `plugin_manifest` from your plugin
+ *  EXAMPLE:
+ *    static constexpr sdk::event_id events[] = { sdk::event_chat_send::EVENT_UID };
+ *    static const sdk::plugin_manifest manifest = {
+ *      .sdk_version = sdk::version,
+ *      .flags       = sdk::manifest_flags::PARALLEL_LOAD | sdk::manifest_flags::LAZY_INIT,
+ *      .init        = &init,
+ *      .events      = events,
+ *      .event_count = 1,
+ *    };
+ *
+ *    MCBRE_PLUGIN_MANIFEST(manifest)
+ */
+#define MCBRE_PLUGIN_MANIFEST(manifest) \
+  MCBRE_PLUGIN_EXPORT auto mcbre_plugin_manifest() -> const sdk::plugin_manifest * { return &(manifest); }
+
+/*
+ *  Exports `fn` as your plugin's `mcbre_plugin_init`
+ *  EXAMPLE:
+ *    auto init(sdk::load_info * info) -> bool { ... }
+ *    MCBRE_PLUGIN_INIT(init)
+ */
+#define MCBRE_PLUGIN_INIT(fn) \
+  MCBRE_PLUGIN_EXPORT auto mcbre_plugin_init(sdk::load_info * info) -> bool { return fn(info); }
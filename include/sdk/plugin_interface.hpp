@@ -12,4 +12,25 @@ class plugin_intf : public sdk::sdk_intf {
 public: 
 };
 
+/*
+ *  Hot reload state transfer, see `client_intf::reload_plugin`
+ *
+ *  When a plugin is hot reloaded the new instance is queried with this ID on
+ *  the game thread in between two ticks. The previous instance is still loaded
+ *  but parked, none of its listeners, tasks or continuations run until the query
+ *  returns so its state can be moved without locking. Move your state over from
+ *  `previous` and return true to opt in. Returning false reloads the plugin
+ *  the regular way (unload then load).
+ *  EXAMPLE:
+ *    if (!std::strcmp(id, sdk::hot_reload_info::QUERY_ID)) {
+ *      auto * info = reinterpret_cast<sdk::hot_reload_info *>(ptr);
+ *      ...
+ *    }
+ */
+struct hot_reload_info {
+  static constexpr const char QUERY_ID[] = "sdk_hot_reload";
+
+  plugin_intf * previous; // The instance being replaced, still loaded and callable but no longer called by the client
+};
+
 }
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "sdk_interface.hpp"
+#include "plugin_interface.hpp"
+
+namespace sdk {
+
+/*
+ *  Interface to the Client's task scheduler
+ *  Obtained through `client_intf::get_scheduler`.
+ *
+ *  The client owns a single work stealing pool sized to the cores the game
+ *  leaves idle, shared by every plugin. Use it instead of creating your own
+ *  threads. Tasks must not block on I/O for long periods of time.
+ */
+class scheduler_intf : public sdk::sdk_intf {
+public:
+  using task_fn  = void(*)(void * ctx);
+  using range_fn = void(*)(void * ctx, std::size_t begin, std::size_t end);
+
+  /*
+   *  Submit a task to be run on a worker thread
+   *
+   *  `owner` is the plugin submitting the task, the client waits for the
+   *  plugin's pending tasks to finish before it is unloaded. Tasks submitted
+   *  from a worker are pushed to that worker's local queue.
+   */
+  virtual auto submit(plugin_intf * owner, task_fn fn, void * ctx) -> bool = 0;
+
+  /*
+   *  Split [begin, end) into chunks of at least `grain` items and run `fn` on
+   *  each chunk in parallel. Blocks until every chunk is done, the calling
+   *  thread takes part in running the chunks.
+   */
+  virtual auto parallel_for(std::size_t begin, std::size_t end, std::size_t grain, range_fn fn, void * ctx) -> bool = 0;
+
+  /*
+   *  Queue a continuation that runs on the game thread at the start of the
+   *  next tick. Use it to hand results from a task back to the game.
+   *
+   *  `wait_idle` called on the game thread runs it earlier, `release_all` drops
+   *  it without running it.
+   */
+  virtual auto run_on_game_thread(plugin_intf * owner, task_fn fn, void * ctx) -> bool = 0;
+
+  /*
+   *  Blocks until every task submitted by `owner` is done and every continuation
+   *  it queued has run
+   *
+   *  Continuations only run on the game thread. Called from the game thread the
+   *  owner's pending continuations, including the ones queued by the tasks waited
+   *  for, are run inline before it returns instead of waiting for the next tick.
+   *  Must not be called from one of the owner's own tasks.
+   */
+  virtual auto wait_idle(plugin_intf * owner) -> void = 0;
+
+  /*
+   *  Number of worker threads in the pool, can be 0 in which case tasks
+   *  are run on the game thread in between ticks.
+   */
+  virtual auto worker_count() -> std::size_t = 0;
+
+  // -------------------------------------------------------------------------------------------
+  // -- Helpers
+
+  /*
+   *  Submit a member function of `instance` as a task
+   *  EXAMPLE:
+   *    client->get_scheduler()->submit<&myplugin::rebuild_cache>(mypluginst, mypluginst);
+   */
+  template <auto method, typename T>
+  auto submit(plugin_intf * owner, T * instance) -> bool {
+    return this->submit(owner, +[](void * ctx) { (static_cast<T *>(ctx)->*method)(); }, instance);
+  }
+
+  /*
+   *  Run a member function of `instance` on the game thread next tick
+   */
+  template <auto method, typename T>
+  auto run_on_game_thread(plugin_intf * owner, T * instance) -> bool {
+    return this->run_on_game_thread(owner, +[](void * ctx) { (static_cast<T *>(ctx)->*method)(); }, instance);
+  }
+
+  // -- End of Helpers
+  // -------------------------------------------------------------------------------------------
+};
+
+}
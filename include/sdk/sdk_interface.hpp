@@ -5,6 +5,30 @@
 
 namespace sdk {
 
+/*
+ *  Interned query ID token, see `client_intf::intern_query_id`
+ */
+enum class query_id : std::uint32_t {
+  INVALID = 0,
+};
+
+/*
+ *  Standard query for resolving a named table of function pointers from an implementer.
+ *  Resolve it once and call through the table afterwards instead of going through `query`.
+ *
+ *  The caller fills `name` and `version` and calls `query(vtable_request::QUERY_ID, &req)`.
+ *  The implementer sets `table` and `size` to a table that stays valid until the
+ *  implementer is unregistered. For modules see `event_module_unload` and `vtable_handle`.
+ */
+struct vtable_request {
+  static constexpr const char QUERY_ID[] = "get_vtable";
+
+  const char    * name;    // [in]  Name of the requested table
+  std::uint32_t   version; // [in]  Version of the table the caller was built against
+  const void    * table;   // [out] Pointer to the table
+  std::uint64_t   size;    // [out] sizeof the table, used to check compatibility
+};
+
 class sdk_intf {
 public:
   /*
@@ -19,13 +43,36 @@ public:
    *   module would like to interact with that functionality. The chat parsing module developer
    *   can override query and respond to an ID of "register_callback" while receiving a function
    *   pointer for the ptr arg.
+   *
+   *   To stream data between modules at a high rate use the client's channels instead,
+   *   see `channel_intf`.
    */
   virtual auto query(const char * id,  void * ptr, std::uint64_t size) -> bool = 0;
 
+  /*
+   *   Same as above but keyed by an interned token obtained from `client_intf::intern_query_id`
+   *   instead of a string so implementers can route the query with integer compares.
+   *
+   *   Interning the same ID string always yields the same token so a token and its string
+   *   must be treated the same. Returns false by default, if an implementer does not
+   *   handle tokens fall back to the string variant.
+   *
+   *   Appended after `query` under its own name, an overload would reorder the vtable on MSVC.
+   */
+  virtual auto query_token(query_id id, void * ptr, std::uint64_t size) -> bool {
+    (void)id; (void)ptr; (void)size;
+    return false;
+  }
+
   template <typename T>
   auto query(const char * id, T * ptr) -> bool {
     return this->query(id, ptr, sizeof(T));
   }
+
+  template <typename T>
+  auto query(query_id id, T * ptr) -> bool {
+    return this->query_token(id, ptr, sizeof(T));
+  }
 };
 
 }
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "sdk_interface.hpp"
+#include "plugin_interface.hpp"
+
+namespace sdk {
+
+/*
+ *  Value read from the storage, points straight into the client's mapping
+ */
+struct storage_view {
+  const void  * data;
+  std::size_t   size;
+};
+
+/*
+ *  Interface to the Client's persistent key/value store
+ *  Obtained through `client_intf::get_storage`.
+ *
+ *  The store is a single memory mapped file shared by every plugin, each plugin
+ *  has its own namespace keyed on the plugin's file name so it carries over
+ *  between loads and hot reloads. Nothing is parsed at startup, values are
+ *  read in place.
+ *
+ *  Writes only touch memory on the calling thread, they are batched and flushed
+ *  to disk off the game thread. Records are checksummed and appended before they
+ *  are committed, a crash loses at most the writes that were not flushed yet and
+ *  never corrupts older ones. A plugin's pending writes are flushed when it is
+ *  released. All functions are thread safe.
+ */
+class storage_intf : public sdk::sdk_intf {
+public:
+  using visit_fn = bool(*)(void * ctx, const char * key, std::size_t key_len, storage_view value);
+
+  /*
+   *  Read the value of `key` in the namespace of `owner`
+   *
+   *  Sees the plugin's own pending writes. The view is valid until the end of the
+   *  frame, copy the value out if you need to keep it longer.
+   *  Returns false if the key does not exist.
+   */
+  virtual auto read(plugin_intf * owner, const char * key, std::size_t key_len, storage_view * out) -> bool = 0;
+
+  /*
+   *  Queue a write of `size` bytes from `data` to `key`, the data is copied
+   */
+  virtual auto write(plugin_intf * owner, const char * key, std::size_t key_len, const void * data, std::size_t size) -> bool = 0;
+
+  /*
+   *  Queue the removal of `key`, returns false if it does not exist
+   */
+  virtual auto erase(plugin_intf * owner, const char * key, std::size_t key_len) -> bool = 0;
+
+  /*
+   *  Call `fn` for every key of `owner` starting with `prefix` in lexicographic
+   *  order until it returns false. Do not write to the storage from `fn`.
+   */
+  virtual auto visit(plugin_intf * owner, const char * prefix, std::size_t prefix_len, visit_fn fn, void * ctx) -> void = 0;
+
+  /*
+   *  Blocks until every pending write of `owner` is on disk
+   */
+  virtual auto flush(plugin_intf * owner) -> void = 0;
+
+  // -------------------------------------------------------------------------------------------
+  // -- Helpers
+
+  /*
+   *  Read a trivially copyable value, fails if the stored size does not match
+   *  EXAMPLE:
+   *    settings s;
+   *    if (!storage->read(mypluginst, "settings", &s)) { ... defaults ... }
+   */
+  template <typename T>
+  auto read(plugin_intf * owner, const char * key, T * out) -> bool {
+    static_assert(std::is_trivially_copyable_v<T>, "Stored values must be trivially copyable.");
+
+    storage_view view;
+    if (!this->read(owner, key, std::strlen(key), &view) || view.size != sizeof(T))
+      return false;
+
+    std::memcpy(out, view.data, sizeof(T));
+    return true;
+  }
+
+  template <typename T>
+  auto write(plugin_intf * owner, const char * key, const T & value) -> bool {
+    static_assert(std::is_trivially_copyable_v<T>, "Stored values must be trivially copyable.");
+    return this->write(owner, key, std::strlen(key), &value, sizeof(T));
+  }
+
+  auto erase(plugin_intf * owner, const char * key) -> bool {
+    return this->erase(owner, key, std::strlen(key));
+  }
+
+  // -- End of Helpers
+  // -------------------------------------------------------------------------------------------
+};
+
+}
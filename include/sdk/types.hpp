@@ -1,7 +1,47 @@
 #pragma once
 
+#include <cstdint>
+#include <cstddef>
+
 namespace sdk {
 
 using managed_string = enum class _managed_string;
 
+/*
+ *  Non owning view into the buffer of a `managed_string`
+ *  `data` is null terminated and `size` excludes the terminator.
+ */
+struct mcstr_view {
+  const char  * data;
+  std::size_t   size;
+};
+
+/*
+ *  Integer identifier of an event, see `EVENT_UID` on the event structures
+ */
+using event_id = std::uint32_t;
+
+/*
+ *  32-bit FNV-1a hash of a null terminated string. Usable at compile time
+ *  and produces the same value on the client and on every plugin.
+ */
+constexpr auto fnv1a(const char * str) -> std::uint32_t {
+  std::uint32_t hash = 0x811C9DC5u;
+  while (*str) {
+    hash ^= static_cast<std::uint8_t>(*str++);
+    hash *= 0x01000193u;
+  }
+  return hash;
+}
+
+/*
+ *  Length of a null terminated string, usable at compile time without pulling in <string>
+ */
+constexpr auto cstr_length(const char * str) -> std::size_t {
+  std::size_t length = 0;
+  while (str[length])
+    ++length;
+  return length;
+}
+
 }